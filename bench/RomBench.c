@@ -0,0 +1,324 @@
+#include "RomBench.h"
+#include "core/Device.h"
+#include "core/MMU.h"
+#include "core/APU.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define GB_ROM_BENCH_LINE_LENGTH 4096
+
+#ifdef GB_PROFILE
+#define GB_ROM_BENCH_PROFILED true
+#else
+#define GB_ROM_BENCH_PROFILED false
+#endif
+
+static const char* const _GBProfileSectionNames[GBProfileSectionCount] = {
+    [GBProfileOther]  = "other",
+    [GBProfileCPU]    = "cpu",
+    [GBProfileMemory] = "memory",
+    [GBProfileTimer]  = "timer",
+    [GBProfilePPU]    = "ppu",
+    [GBProfileAPU]    = "apu",
+};
+
+static uint64_t _GBRomBenchNanoseconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+}
+
+GBRomBench* GBRomBenchCreate(uint32_t frames, uint32_t runs) {
+    GBRomBench* bench = calloc(1, sizeof(GBRomBench));
+    if (bench == NULL) {
+        return NULL;
+    }
+    bench->frames = frames > 0 ? frames : 1;
+    bench->runs = runs > 0 ? runs : 1;
+    return bench;
+}
+
+bool GBRomBenchAddRom(GBRomBench* bench, const char* path) {
+    if (bench->count == bench->capacity) {
+        uint32_t capacity = bench->capacity ? bench->capacity * 2 : 16;
+        GBRomBenchEntry* entries = realloc(bench->entries, sizeof(GBRomBenchEntry) * capacity);
+        if (entries == NULL) {
+            return false;
+        }
+        bench->entries = entries;
+        bench->capacity = capacity;
+    }
+    GBRomBenchEntry* entry = &bench->entries[bench->count];
+    memset(entry, 0, sizeof(GBRomBenchEntry));
+    entry->path = strdup(path);
+    if (entry->path == NULL) {
+        return false;
+    }
+    bench->count++;
+    return true;
+}
+
+bool GBRomBenchAddList(GBRomBench* bench, const char* listPath) {
+    FILE* file = fopen(listPath, "r");
+    if (file == NULL) {
+        return false;
+    }
+    char line[GB_ROM_BENCH_LINE_LENGTH];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        char* path = line + strspn(line, " \t");
+        if (*path == '\0' || *path == '#') {
+            continue;
+        }
+        GBRomBenchAddRom(bench, path);
+    }
+    fclose(file);
+    return true;
+}
+
+void GBRomBenchFree(GBRomBench* bench) {
+    if (bench == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < bench->count; i++) {
+        free(bench->entries[i].path);
+    }
+    free(bench->entries);
+    free(bench);
+}
+
+static GB_device* _GBRomBenchNewDevice(const char* path) {
+    GB_device* device = GB_newDevice();
+    if (device == NULL) {
+        return NULL;
+    }
+    GBApuSetSampleRate(device, GB_BENCH_SAMPLE_RATE);
+    if (GB_deviceloadRom(device, path) != GB_CARTRIDGE_SUCCESS) {
+        GB_freeDevice(device);
+        return NULL;
+    }
+    return device;
+}
+
+static void _GBRomBenchRunFrames(GB_device* device, uint32_t frames) {
+    for (uint32_t i = 0; i < frames; i++) {
+        GB_runFrame(device);
+        GBApuSkipSamples(device, GBApuSamplesAvailable(device));
+    }
+}
+
+// Wall time of one run from power on, in ns
+static uint64_t _GBRomBenchTimeRun(GB_device* device, uint32_t frames) {
+    uint64_t start = _GBRomBenchNanoseconds();
+    _GBRomBenchRunFrames(device, frames);
+    return _GBRomBenchNanoseconds() - start;
+}
+
+#ifdef GB_PROFILE
+// One run from power on with the counters on, only for their proportions
+static void _GBRomBenchProfileRun(GB_device* device, uint32_t frames) {
+    GBProfileStart(&device->profile);
+    _GBRomBenchRunFrames(device, frames);
+    GBProfileStop(&device->profile);
+}
+#endif
+
+static bool _GBRomBenchMeasure(GBRomBench* bench, GBRomBenchEntry* entry) {
+    uint64_t best = UINT64_MAX;
+    for (uint32_t run = 0; run < bench->runs; run++) {
+        GB_device* device = _GBRomBenchNewDevice(entry->path);
+        if (device == NULL) {
+            return false;
+        }
+        uint64_t ns = _GBRomBenchTimeRun(device, bench->frames);
+        if (ns < best) {
+            best = ns;
+        }
+        GB_freeDevice(device);
+    }
+    entry->nsPerFrame = (double)best / bench->frames;
+    entry->framesPerSecond = entry->nsPerFrame > 0 ? 1e9 / entry->nsPerFrame : 0;
+
+#ifdef GB_PROFILE
+    GB_device* device = _GBRomBenchNewDevice(entry->path);
+    if (device == NULL) {
+        return false;
+    }
+    _GBRomBenchProfileRun(device, bench->frames);
+    uint64_t ticks = 0;
+    for (int section = 0; section < GBProfileSectionCount; section++) {
+        ticks += device->profile.ticks[section];
+    }
+    for (int section = 0; section < GBProfileSectionCount && ticks > 0; section++) {
+        entry->sectionNsPerFrame[section] = entry->nsPerFrame * device->profile.ticks[section] / ticks;
+    }
+    GB_freeDevice(device);
+#endif
+    return true;
+}
+
+uint32_t GBRomBenchRun(GBRomBench* bench, FILE* log) {
+    uint32_t failed = 0;
+    for (uint32_t i = 0; i < bench->count; i++) {
+        GBRomBenchEntry* entry = &bench->entries[i];
+        entry->loaded = _GBRomBenchMeasure(bench, entry);
+        if (entry->loaded == false) {
+            failed++;
+            if (log != NULL) {
+                fprintf(log, "[%u/%u] %s could not be loaded\n", i + 1, bench->count, entry->path);
+            }
+            continue;
+        }
+        if (log != NULL) {
+            fprintf(log, "[%u/%u] %s: %.1f fps, %.0f ns/frame\n", i + 1, bench->count,
+                    entry->path, entry->framesPerSecond, entry->nsPerFrame);
+            fflush(log);
+        }
+    }
+    return failed;
+}
+
+double GBRomBenchTotalNsPerFrame(const GBRomBench* bench) {
+    double ns = 0;
+    uint32_t loaded = 0;
+    for (uint32_t i = 0; i < bench->count; i++) {
+        if (bench->entries[i].loaded) {
+            ns += bench->entries[i].nsPerFrame;
+            loaded++;
+        }
+    }
+    return loaded > 0 ? ns / loaded : 0;
+}
+
+static void _GBRomBenchWriteString(FILE* out, const char* string) {
+    fputc('"', out);
+    for (const char* c = string; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', out);
+        }
+        fputc(*c, out);
+    }
+    fputc('"', out);
+}
+
+bool GBRomBenchWriteJSON(const GBRomBench* bench, FILE* out) {
+    fprintf(out, "{\n");
+    fprintf(out, "  \"frames\": %u,\n", bench->frames);
+    fprintf(out, "  \"runs\": %u,\n", bench->runs);
+    fprintf(out, "  \"profiled\": %s,\n", GB_ROM_BENCH_PROFILED ? "true" : "false");
+    fprintf(out, "  \"roms\": [\n");
+    bool first = true;
+    for (uint32_t i = 0; i < bench->count; i++) {
+        const GBRomBenchEntry* entry = &bench->entries[i];
+        if (entry->loaded == false) {
+            continue;
+        }
+        fprintf(out, "%s    {\"rom\": ", first ? "" : ",\n");
+        _GBRomBenchWriteString(out, entry->path);
+        fprintf(out, ", \"fps\": %.2f, \"nsPerFrame\": %.0f, \"breakdown\": {",
+                entry->framesPerSecond, entry->nsPerFrame);
+        for (int section = 0; section < GBProfileSectionCount; section++) {
+            fprintf(out, "%s\"%s\": %.0f", section == 0 ? "" : ", ",
+                    _GBProfileSectionNames[section], entry->sectionNsPerFrame[section]);
+        }
+        fprintf(out, "}}");
+        first = false;
+    }
+    double total = GBRomBenchTotalNsPerFrame(bench);
+    fprintf(out, "\n  ],\n");
+    fprintf(out, "  \"total\": {\"fps\": %.2f, \"nsPerFrame\": %.0f}\n", total > 0 ? 1e9 / total : 0, total);
+    fprintf(out, "}\n");
+    return ferror(out) == 0;
+}
+
+// Reads the string starting at the opening quote `c`, returns the end of
+// the string or NULL
+static const char* _GBRomBenchReadString(const char* c, char* string, size_t length) {
+    if (*c++ != '"') {
+        return NULL;
+    }
+    size_t i = 0;
+    for (; *c != '\0' && *c != '"'; c++) {
+        if (*c == '\\' && c[1] != '\0') {
+            c++;
+        }
+        if (i + 1 < length) {
+            string[i++] = *c;
+        }
+    }
+    string[i] = '\0';
+    return *c == '"' ? c + 1 : NULL;
+}
+
+static bool _GBRomBenchReadNumber(const char* c, const char* key, double* value) {
+    const char* found = strstr(c, key);
+    if (found == NULL) {
+        return false;
+    }
+    char* end;
+    *value = strtod(found + strlen(key), &end);
+    return end != found + strlen(key);
+}
+
+static int _GBRomBenchCompareLine(FILE* out, const char* name, double base, double now, double threshold) {
+    double delta = base > 0 ? (now - base) * 100 / base : 0;
+    bool regressed = delta > threshold;
+    fprintf(out, "%s %-44s %12.0f %12.0f %+8.2f%%\n", regressed ? "⛔️" : "  ", name, base, now, delta);
+    return regressed ? 1 : 0;
+}
+
+int GBRomBenchCompare(const GBRomBench* bench, const char* baselinePath, double threshold, FILE* out) {
+    FILE* file = fopen(baselinePath, "r");
+    if (file == NULL) {
+        return -1;
+    }
+    int regressions = 0;
+    bool printedHeader = false;
+    char line[GB_ROM_BENCH_LINE_LENGTH];
+    char path[GB_ROM_BENCH_LINE_LENGTH];
+    double baseTotal = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        const char* rom = strstr(line, "\"rom\": ");
+        double base;
+        const char* profiled = strstr(line, "\"profiled\": ");
+        if (profiled != NULL) {
+            // the counters alone move the times, the two builds never compare
+            bool baseProfiled = strncmp(profiled + strlen("\"profiled\": "), "true", 4) == 0;
+            if (baseProfiled != GB_ROM_BENCH_PROFILED) {
+                fprintf(out, "%s was measured %s the profile counters\n", baselinePath, baseProfiled ? "with" : "without");
+                fclose(file);
+                return -1;
+            }
+            continue;
+        }
+        if (printedHeader == false && (rom != NULL || strstr(line, "\"total\": ") != NULL)) {
+            fprintf(out, "   %-44s %12s %12s %9s\n", "ns/frame", "baseline", "current", "change");
+            printedHeader = true;
+        }
+        if (rom == NULL) {
+            if (strstr(line, "\"total\": ") != NULL) {
+                _GBRomBenchReadNumber(line, "\"nsPerFrame\": ", &baseTotal);
+            }
+            continue;
+        }
+        const char* end = _GBRomBenchReadString(rom + strlen("\"rom\": "), path, sizeof(path));
+        if (end == NULL || _GBRomBenchReadNumber(end, "\"nsPerFrame\": ", &base) == false) {
+            continue;
+        }
+        for (uint32_t i = 0; i < bench->count; i++) {
+            const GBRomBenchEntry* entry = &bench->entries[i];
+            if (entry->loaded && strcmp(entry->path, path) == 0) {
+                const char* name = strrchr(path, '/') ? strrchr(path, '/') + 1 : path;
+                regressions += _GBRomBenchCompareLine(out, name, base, entry->nsPerFrame, threshold);
+                break;
+            }
+        }
+    }
+    fclose(file);
+    if (baseTotal > 0) {
+        regressions += _GBRomBenchCompareLine(out, "total", baseTotal, GBRomBenchTotalNsPerFrame(bench), threshold);
+    }
+    return regressions;
+}
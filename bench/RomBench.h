@@ -0,0 +1,77 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "core/Profile.h"
+
+// Headless whole-ROM benchmark.
+//
+// Every ROM runs from power on for a fixed number of emulated frames with
+// the APU synthesizing at 48 kHz (samples are discarded), so the numbers
+// cover everything a player pays for except presenting the frame.
+// Each ROM is timed `runs` times and the fastest run is kept.
+// The `bench` target builds the core as shipped, its times are the ones to
+// track and compare. The `bench-profile` target builds it with GB_PROFILE:
+// even switched off, the counters cost a branch per section, so its times
+// are only good for the breakdown. One more run with the counters on gives
+// the share of each subsystem, which is then applied to the fastest run:
+// the timestamps slow the emulation down but barely move the proportions.
+//
+// A ROM list holds one path per line, relative to the working directory.
+// Blank lines and lines starting with '#' are ignored.
+
+#define GB_BENCH_SAMPLE_RATE 48000
+
+struct GBRomBenchEntry_s {
+    char* path;
+
+    // filled in by GBRomBenchRun
+    bool loaded;
+    double framesPerSecond;
+    double nsPerFrame;
+    // nsPerFrame split by GBProfileSection, all zero unless built with
+    // GB_PROFILE
+    double sectionNsPerFrame[GBProfileSectionCount];
+};
+
+typedef struct GBRomBenchEntry_s GBRomBenchEntry;
+
+struct GBRomBench_s {
+    GBRomBenchEntry* entries;
+    uint32_t count;
+    uint32_t capacity;
+
+    uint32_t frames;
+    uint32_t runs;
+};
+
+typedef struct GBRomBench_s GBRomBench;
+
+GBRomBench* GBRomBenchCreate(uint32_t frames, uint32_t runs);
+bool GBRomBenchAddRom(GBRomBench* bench, const char* path);
+// Returns false if the file cannot be read
+bool GBRomBenchAddList(GBRomBench* bench, const char* listPath);
+void GBRomBenchFree(GBRomBench* bench);
+
+// Runs every ROM, reporting progress on `log` (may be NULL). Returns the
+// number of ROMs that could not be loaded.
+uint32_t GBRomBenchRun(GBRomBench* bench, FILE* log);
+
+// Mean ns per frame over the loaded ROMs, every ROM weighs the same
+double GBRomBenchTotalNsPerFrame(const GBRomBench* bench);
+
+// JSON report, one ROM object per line:
+//
+//     {"rom": "<path>", "fps": 1234.5, "nsPerFrame": 810000, "breakdown": {"cpu": ..., ...}}
+//
+// GBRomBenchCompare reads such a report back and prints, for each ROM in
+// both, the change in ns per frame. ROMs (and the total) more than
+// `threshold` percent slower count as regressions. Returns the number of
+// regressions, or -1 if the baseline cannot be read or comes from the
+// other build (profiled or not).
+// The baseline is not parsed as JSON but line by line: it must keep the
+// layout GBRomBenchWriteJSON writes, with each ROM object, and the total,
+// whole on its own line and "rom" before "nsPerFrame".
+bool GBRomBenchWriteJSON(const GBRomBench* bench, FILE* out);
+int GBRomBenchCompare(const GBRomBench* bench, const char* baselinePath, double threshold, FILE* out);
@@ -0,0 +1,120 @@
+#include "RomBench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_DEFAULT_LIST "bench/default.roms"
+#define BENCH_DEFAULT_FRAMES 600
+#define BENCH_DEFAULT_RUNS 3
+// percent of slowdown in ns/frame reported as a regression
+#define BENCH_DEFAULT_THRESHOLD 5.0
+
+static void usage(const char* name) {
+    printf("usage: %s [--frames N] [--runs N] [--list <file>] [--json <out>]\n"
+           "          [--baseline <json> [--threshold <percent>]] [rom ...]\n"
+           "Runs each ROM (default: the ROMs in %s) headless for N frames.\n"
+           "--json writes the results, --baseline compares them with a saved\n"
+           "report and exits with 1 if anything got slower than the threshold.\n"
+           "The per-subsystem breakdown needs the bench-profile build.\n",
+           name, BENCH_DEFAULT_LIST);
+}
+
+#ifdef GB_PROFILE
+static void printBreakdown(const GBRomBench* bench) {
+    printf("----------------------------\n");
+    printf("%-32s %9s %9s %9s %9s %9s %9s\n", "ns/frame", "cpu", "memory", "timer", "ppu", "apu", "other");
+    for (uint32_t i = 0; i < bench->count; i++) {
+        const GBRomBenchEntry* entry = &bench->entries[i];
+        if (entry->loaded == false) {
+            continue;
+        }
+        const char* name = strrchr(entry->path, '/') ? strrchr(entry->path, '/') + 1 : entry->path;
+        const double* ns = entry->sectionNsPerFrame;
+        printf("%-32.32s %9.0f %9.0f %9.0f %9.0f %9.0f %9.0f\n", name, ns[GBProfileCPU], ns[GBProfileMemory],
+               ns[GBProfileTimer], ns[GBProfilePPU], ns[GBProfileAPU], ns[GBProfileOther]);
+    }
+}
+#endif
+
+int main(int argc, const char * argv[]) {
+    uint32_t frames = BENCH_DEFAULT_FRAMES;
+    uint32_t runs = BENCH_DEFAULT_RUNS;
+    const char* list = NULL;
+    const char* jsonPath = NULL;
+    const char* baseline = NULL;
+    double threshold = BENCH_DEFAULT_THRESHOLD;
+
+    GBRomBench* bench = GBRomBenchCreate(frames, runs);
+    if (bench == NULL) {
+        printf("⛔️ could not create the benchmark\n");
+        return 2;
+    }
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--frames") == 0 && hasValue) {
+            frames = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--runs") == 0 && hasValue) {
+            runs = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--list") == 0 && hasValue) {
+            list = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && hasValue) {
+            jsonPath = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && hasValue) {
+            baseline = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && hasValue) {
+            threshold = atof(argv[++i]);
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            GBRomBenchFree(bench);
+            return 2;
+        } else {
+            GBRomBenchAddRom(bench, argv[i]);
+        }
+    }
+    bench->frames = frames > 0 ? frames : 1;
+    bench->runs = runs > 0 ? runs : 1;
+    if (bench->count == 0 && list == NULL) {
+        list = BENCH_DEFAULT_LIST;
+    }
+    if (list != NULL && GBRomBenchAddList(bench, list) == false) {
+        printf("⛔️ could not read %s\n", list);
+        GBRomBenchFree(bench);
+        return 2;
+    }
+
+    printf("%u frames, best of %u runs\n", bench->frames, bench->runs);
+    printf("----------------------------\n");
+    uint32_t failed = GBRomBenchRun(bench, stdout);
+    double total = GBRomBenchTotalNsPerFrame(bench);
+    printf("----------------------------\n");
+    printf("mean: %.1f fps, %.0f ns/frame\n", total > 0 ? 1e9 / total : 0, total);
+#ifdef GB_PROFILE
+    printBreakdown(bench);
+#endif
+
+    int status = failed == 0 ? 0 : 1;
+    if (jsonPath != NULL) {
+        FILE* out = fopen(jsonPath, "w");
+        if (out == NULL || GBRomBenchWriteJSON(bench, out) == false) {
+            printf("⛔️ could not write %s\n", jsonPath);
+            status = 2;
+        }
+        if (out != NULL) {
+            fclose(out);
+        }
+    }
+    if (baseline != NULL) {
+        printf("----------------------------\n");
+        int regressions = GBRomBenchCompare(bench, baseline, threshold, stdout);
+        if (regressions < 0) {
+            printf("⛔️ could not compare with %s\n", baseline);
+            status = 2;
+        } else if (regressions > 0) {
+            printf("%d regression(s) over %.1f%%\n", regressions, threshold);
+            status = status == 0 ? 1 : status;
+        }
+    }
+    GBRomBenchFree(bench);
+    return status;
+}
@@ -0,0 +1,367 @@
+#include "MicroBench.h"
+#include "core/Device.h"
+#include "core/CPU.h"
+#include "core/MMU.h"
+#include "core/PPU.h"
+#include "core/APU.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Synthetic machine: 4 banks of noise as ROM, bank 2 mapped at 0x4000,
+// boot ROM unmapped. Nothing is loaded from disk.
+#define MICRO_ROM_BANKS 4
+#define MICRO_ROM_SIZE (MICRO_ROM_BANKS * 0x4000)
+
+#define MICRO_PROGRAM_START 0xC000
+// enough repeats that the closing JP is noise
+#define MICRO_PROGRAM_LENGTH 0x0C00
+#define MICRO_CALL_TARGET 0xD000
+#define MICRO_HL_TARGET 0xD800
+#define MICRO_STACK_TOP 0xDFF0
+
+#define MICRO_APU_SAMPLE_RATE 48000
+// cycles between two APU frame sequencer steps (DIV bit 12, 512 Hz)
+#define MICRO_APU_DIV_CYCLES 8192
+
+struct MicroState_s {
+    GB_device* device;
+    Byte* rom;
+    uint32_t index;
+    uint32_t cycles;
+};
+
+typedef struct MicroState_s MicroState;
+
+static uint32_t _microRandom(uint32_t* seed) {
+    // xorshift32, the same noise on every run
+    uint32_t x = *seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *seed = x;
+    return x;
+}
+
+static MicroState* _microNewState(GBApuAudioMode audioMode) {
+    MicroState* state = calloc(1, sizeof(MicroState));
+    if (state == NULL) {
+        return NULL;
+    }
+    state->device = GB_newDevice();
+    state->rom = malloc(MICRO_ROM_SIZE);
+    if (state->device == NULL || state->rom == NULL) {
+        if (state->device != NULL) {
+            GB_freeDevice(state->device);
+        }
+        free(state->rom);
+        free(state);
+        return NULL;
+    }
+    uint32_t seed = 0x2545F491;
+    for (uint32_t i = 0; i < MICRO_ROM_SIZE; i++) {
+        state->rom[i] = _microRandom(&seed);
+    }
+
+    GB_device* device = state->device;
+    GBApuSetAudioMode(device, audioMode);
+    device->mmu.rom = state->rom;
+    device->mmu.romShared = true; // freed with the state
+    device->mmu.romSize = MICRO_ROM_SIZE;
+    device->mmu.romBanking = true;
+    device->mmu.romBankCount = MICRO_ROM_BANKS;
+    device->mmu.romBank = 2;
+    device->mmu.in_bios = false;
+    return state;
+}
+
+static void _microFreeState(void* opaque) {
+    MicroState* state = opaque;
+    GB_freeDevice(state->device);
+    free(state->rom);
+    free(state);
+}
+
+// MARK: GB_deviceReadByte per region
+
+struct MicroReadRegion_s {
+    Word base;
+    // offsets walk base + (i & mask)
+    Word mask;
+};
+
+typedef struct MicroReadRegion_s MicroReadRegion;
+
+static const MicroReadRegion microReadRegions[] = {
+    { 0x0200, 0xFF }, // ROM bank 0
+    { 0x4200, 0xFF }, // switchable ROM bank
+    { 0x8000, 0xFF }, // VRAM
+    { 0xA000, 0xFF }, // external RAM
+    { 0xC000, 0xFF }, // WRAM
+    { 0xE000, 0xFF }, // echo RAM
+    { 0xFE00, 0x7F }, // OAM
+    { 0xFF10, 0x0F }, // APU registers
+    { 0xFF40, 0x07 }, // PPU registers
+    { 0xFF80, 0x3F }, // HRAM
+};
+
+static void* _microReadSetup(uintptr_t parameter) {
+    MicroState* state = _microNewState(GBApuAudioModeHeadless);
+    if (state != NULL) {
+        state->index = (uint32_t)parameter;
+        // APU registers only read back while it is powered
+        GBWriteToAPURegister(state->device, 0xFF26, 0x80);
+    }
+    return state;
+}
+
+static void _microReadRun(void* opaque, uint64_t ops) {
+    MicroState* state = opaque;
+    GB_device* device = state->device;
+    MicroReadRegion region = microReadRegions[state->index];
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < ops; i++) {
+        sum += GB_deviceReadByte(device, region.base + (i & region.mask));
+    }
+    GBMicroBenchSink += sum;
+}
+
+// MARK: opcode dispatch per instruction class
+
+struct MicroOpcodeClass_s {
+    Byte pattern[8];
+    uint8_t length;
+};
+
+typedef struct MicroOpcodeClass_s MicroOpcodeClass;
+
+// A few opcodes of each class so dispatch is not a single predicted
+// target. Registers are set so every pattern loops forever in WRAM.
+static const MicroOpcodeClass microOpcodeClasses[] = {
+    { { 0x00 }, 1 },                                           // NOP
+    { { 0x41, 0x4A, 0x53, 0x5C }, 4 },                         // LD r,r
+    { { 0x06, 0x12, 0x0E, 0x34 }, 4 },                         // LD r,d8
+    { { 0x80, 0x91, 0xA2, 0xB3 }, 4 },                         // ALU A,r
+    { { 0x03, 0x13, 0x0B, 0x1B }, 4 },                         // INC/DEC rr
+    { { 0x7E, 0x77 }, 2 },                                     // LD A,(HL) / LD (HL),A
+    { { 0xC5, 0xD5, 0xD1, 0xC1 }, 4 },                         // PUSH/POP
+    { { 0x18, 0x00 }, 2 },                                     // JR +0
+    { { 0xCD, MICRO_CALL_TARGET & 0xFF, MICRO_CALL_TARGET >> 8 }, 3 }, // CALL + RET
+    { { 0xCB, 0x47, 0xCB, 0x37, 0xCB, 0x11, 0xCB, 0x3F }, 8 },   // CB prefixed
+};
+
+static void* _microDispatchSetup(uintptr_t parameter) {
+    MicroState* state = _microNewState(GBApuAudioModeHeadless);
+    if (state == NULL) {
+        return NULL;
+    }
+    GB_device* device = state->device;
+    // dispatch, operands and the per-access timer/APU advance, no PPU
+    device->ppuDisabled = true;
+
+    const MicroOpcodeClass* opcodes = &microOpcodeClasses[parameter];
+    Word addr = MICRO_PROGRAM_START;
+    while (addr + opcodes->length < MICRO_PROGRAM_START + MICRO_PROGRAM_LENGTH) {
+        for (int i = 0; i < opcodes->length; i++) {
+            GB_deviceWriteByte(device, addr++, opcodes->pattern[i]);
+        }
+    }
+    GB_deviceWriteByte(device, addr++, 0xC3); // JP start
+    GB_deviceWriteByte(device, addr++, MICRO_PROGRAM_START & 0xFF);
+    GB_deviceWriteByte(device, addr++, MICRO_PROGRAM_START >> 8);
+    GB_deviceWriteByte(device, MICRO_CALL_TARGET, 0xC9); // RET
+
+    device->cpu.registers.pc = MICRO_PROGRAM_START;
+    device->cpu.registers.sp = MICRO_STACK_TOP;
+    device->cpu.registers.h = MICRO_HL_TARGET >> 8;
+    device->cpu.registers.l = MICRO_HL_TARGET & 0xFF;
+    return state;
+}
+
+static void _microDispatchRun(void* opaque, uint64_t ops) {
+    GB_device* device = ((MicroState*)opaque)->device;
+    for (uint64_t i = 0; i < ops; i++) {
+        GB_deviceCpuStep(device);
+    }
+}
+
+// MARK: GB_deviceVramWrite
+
+static void* _microVramSetup(uintptr_t parameter) {
+    MicroState* state = _microNewState(GBApuAudioModeHeadless);
+    if (state != NULL) {
+        state->index = (uint32_t)parameter;
+    }
+    return state;
+}
+
+static void _microVramRun(void* opaque, uint64_t ops) {
+    MicroState* state = opaque;
+    GB_device* device = state->device;
+    // tile data decodes a row on every write, the tile maps do not
+    Word base = state->index;
+    Word size = base < 0x9800 ? 0x1800 : 0x800;
+    uint32_t offset = 0;
+    for (uint64_t i = 0; i < ops; i++) {
+        GB_deviceVramWrite(device, base + offset, (Byte)(i * 0x9D));
+        offset = offset + 1 < size ? offset + 1 : 0;
+    }
+}
+
+// MARK: PPU, one visible line
+
+#define MICRO_PPU_OBJECTS 40
+
+static void* _microPpuSetup(uintptr_t parameter) {
+    MicroState* state = _microNewState(GBApuAudioModeHeadless);
+    if (state == NULL) {
+        return NULL;
+    }
+    GB_device* device = state->device;
+    uint32_t seed = 0x9E3779B9;
+    for (Word addr = 0x8000; addr < 0xA000; addr++) {
+        GB_deviceVramWrite(device, addr, _microRandom(&seed));
+    }
+    // objects spread over the screen, a few per line
+    for (int i = 0; i < MICRO_PPU_OBJECTS; i++) {
+        device->ppu.oam[i * 4 + 0] = 16 + (i * 37) % 144;
+        device->ppu.oam[i * 4 + 1] = 8 + (i * 53) % 160;
+        device->ppu.oam[i * 4 + 2] = _microRandom(&seed);
+        device->ppu.oam[i * 4 + 3] = _microRandom(&seed) & 0xE0;
+    }
+    GB_devicePPUIOWrite(device, 0xFF47, 0xE4);
+    GB_devicePPUIOWrite(device, 0xFF48, 0xD2);
+    GB_devicePPUIOWrite(device, 0xFF4A, 72);
+    GB_devicePPUIOWrite(device, 0xFF4B, 87);
+    // parameter is LCDC
+    GB_devicePPUIOWrite(device, 0xFF40, (Byte)parameter);
+    return state;
+}
+
+static void _microPpuRun(void* opaque, uint64_t ops) {
+    GB_device* device = ((MicroState*)opaque)->device;
+    GB_ppu* ppu = &device->ppu;
+    for (uint64_t i = 0; i < ops; i++) {
+        Byte line = ppu->line;
+        while (ppu->line == line) {
+            GB_devicePPUstep(device, 4);
+        }
+        if (ppu->line >= 144) {
+            // skip V-Blank, only drawn lines are measured
+            ppu->line = 0;
+            ppu->clock = 0;
+            ppu->lineMode = GB_PPU_MODE_OAM_SCAN;
+            ppu->frameReady = false;
+        }
+    }
+}
+
+// MARK: GB_ppu_gen_frame_bitmap
+
+static void* _microBitmapSetup(uintptr_t parameter) {
+    MicroState* state = _microNewState(GBApuAudioModeHeadless);
+    if (state == NULL) {
+        return NULL;
+    }
+    GB_ppu* ppu = &state->device->ppu;
+    uint32_t seed = 0x85EBCA6B;
+    for (int i = 0; i < 160 * 144; i++) {
+        uint32_t noise = _microRandom(&seed);
+        ppu->frameBuffer[GBBackgroundFrameBuffer][i] = noise & 0x3;
+        // about one pixel in four covered by an object
+        ppu->frameBuffer[GBObjectFrameBuffer][i] = (noise >> 2 & 0x3) == 0 ? (noise >> 4 & 0x3) : GB_Tile_pixel_0;
+        ppu->objPriorities[i] = noise >> 6 & 0x1;
+    }
+    return state;
+}
+
+static void _microBitmapRun(void* opaque, uint64_t ops) {
+    GB_device* device = ((MicroState*)opaque)->device;
+    for (uint64_t i = 0; i < ops; i++) {
+        uint8_t* bitmap = GB_ppu_gen_frame_bitmap(device);
+        GBMicroBenchSink += bitmap[i % (160 * 144 * 4)];
+        free(bitmap);
+    }
+}
+
+// MARK: GBApuStep
+
+static void* _microApuSetup(uintptr_t parameter) {
+    GBApuAudioMode audioMode = (GBApuAudioMode)parameter;
+    MicroState* state = _microNewState(audioMode);
+    if (state == NULL) {
+        return NULL;
+    }
+    GB_device* device = state->device;
+    if (audioMode != GBApuAudioModeHeadless) {
+        GBApuSetSampleRate(device, MICRO_APU_SAMPLE_RATE);
+    }
+    // all four channels playing, no length counter so none of them stops
+    static const Word registers[][2] = {
+        { 0xFF26, 0x80 }, { 0xFF24, 0x77 }, { 0xFF25, 0xFF },
+        { 0xFF11, 0x80 }, { 0xFF12, 0xF0 }, { 0xFF13, 0x73 }, { 0xFF14, 0x86 },
+        { 0xFF16, 0x40 }, { 0xFF17, 0xA0 }, { 0xFF18, 0x21 }, { 0xFF19, 0x87 },
+        { 0xFF1A, 0x80 }, { 0xFF1C, 0x20 }, { 0xFF1D, 0x40 }, { 0xFF1E, 0x85 },
+        { 0xFF21, 0xF0 }, { 0xFF22, 0x22 }, { 0xFF23, 0x80 },
+    };
+    uint32_t seed = 0xC2B2AE35;
+    GBWriteToAPURegister(device, 0xFF26, 0x80);
+    for (Word addr = 0xFF30; addr < 0xFF40; addr++) {
+        GBWriteToAPURegister(device, addr, _microRandom(&seed));
+    }
+    for (size_t i = 0; i < sizeof(registers) / sizeof(registers[0]); i++) {
+        GBWriteToAPURegister(device, registers[i][0], (Byte)registers[i][1]);
+    }
+    return state;
+}
+
+static void _microApuRun(void* opaque, uint64_t ops) {
+    MicroState* state = opaque;
+    GB_device* device = state->device;
+    for (uint64_t i = 0; i < ops; i++) {
+        for (int step = 0; step < 1000 / 4; step++) {
+            GBApuStep(device, 4);
+        }
+        state->cycles += 1000;
+        if (state->cycles >= MICRO_APU_DIV_CYCLES) {
+            state->cycles -= MICRO_APU_DIV_CYCLES;
+            GBApuDiv(device);
+        }
+        GBApuSkipSamples(device, GBApuSamplesAvailable(device));
+    }
+}
+
+#define MICRO_CASE(name, unit, prefix, parameter) \
+    { name, unit, _micro##prefix##Setup, _micro##prefix##Run, _microFreeState, (uintptr_t)(parameter) }
+
+const GBMicroBenchCase GBMicroBenchCases[] = {
+    MICRO_CASE("read/rom0",            "read",        Read, 0),
+    MICRO_CASE("read/romx",            "read",        Read, 1),
+    MICRO_CASE("read/vram",            "read",        Read, 2),
+    MICRO_CASE("read/eram",            "read",        Read, 3),
+    MICRO_CASE("read/wram",            "read",        Read, 4),
+    MICRO_CASE("read/echo",            "read",        Read, 5),
+    MICRO_CASE("read/oam",             "read",        Read, 6),
+    MICRO_CASE("read/io-apu",          "read",        Read, 7),
+    MICRO_CASE("read/io-ppu",          "read",        Read, 8),
+    MICRO_CASE("read/hram",            "read",        Read, 9),
+    MICRO_CASE("dispatch/nop",         "instruction", Dispatch, 0),
+    MICRO_CASE("dispatch/ld-r-r",      "instruction", Dispatch, 1),
+    MICRO_CASE("dispatch/ld-r-d8",     "instruction", Dispatch, 2),
+    MICRO_CASE("dispatch/alu",         "instruction", Dispatch, 3),
+    MICRO_CASE("dispatch/inc-dec-16",  "instruction", Dispatch, 4),
+    MICRO_CASE("dispatch/ld-hl-mem",   "instruction", Dispatch, 5),
+    MICRO_CASE("dispatch/push-pop",    "instruction", Dispatch, 6),
+    MICRO_CASE("dispatch/jr",          "instruction", Dispatch, 7),
+    MICRO_CASE("dispatch/call-ret",    "instruction", Dispatch, 8),
+    MICRO_CASE("dispatch/cb",          "instruction", Dispatch, 9),
+    MICRO_CASE("vram-write/tile-data", "write",       Vram, 0x8000),
+    MICRO_CASE("vram-write/tile-map",  "write",       Vram, 0x9800),
+    MICRO_CASE("ppu-line/bg",          "line",        Ppu, 0x91),
+    MICRO_CASE("ppu-line/bg-win-obj",  "line",        Ppu, 0xF3),
+    MICRO_CASE("frame-bitmap",         "frame",       Bitmap, 0),
+    MICRO_CASE("apu-step/full",        "1000 cycles", Apu, GBApuAudioModeFull),
+    MICRO_CASE("apu-step/headless",    "1000 cycles", Apu, GBApuAudioModeHeadless),
+};
+
+const uint32_t GBMicroBenchCaseCount = sizeof(GBMicroBenchCases) / sizeof(GBMicroBenchCases[0]);
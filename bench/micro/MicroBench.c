@@ -0,0 +1,103 @@
+#include "MicroBench.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// a sample never grows past this many operations while sizing
+#define GB_MICRO_BENCH_MAX_OPS (1ull << 32)
+
+volatile uint64_t GBMicroBenchSink;
+
+static uint64_t _GBMicroBenchNanoseconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+}
+
+static uint64_t _GBMicroBenchTime(const GBMicroBenchCase* benchCase, void* state, uint64_t ops) {
+    uint64_t start = _GBMicroBenchNanoseconds();
+    benchCase->run(state, ops);
+    return _GBMicroBenchNanoseconds() - start;
+}
+
+static int _GBMicroBenchCompareDoubles(const void* a, const void* b) {
+    double lhs = *(const double*)a;
+    double rhs = *(const double*)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+double GBMicroBenchPercentile(const double* sorted, uint32_t count, double percentile) {
+    if (count == 0) {
+        return 0;
+    }
+    double rank = percentile / 100 * (count - 1);
+    uint32_t lower = (uint32_t)rank;
+    if (lower + 1 >= count) {
+        return sorted[count - 1];
+    }
+    double fraction = rank - lower;
+    return sorted[lower] + (sorted[lower + 1] - sorted[lower]) * fraction;
+}
+
+bool GBMicroBenchRun(const GBMicroBenchCase* benchCase, GBMicroBenchOptions options, GBMicroBenchResult* result) {
+    void* state = benchCase->setup(benchCase->parameter);
+    if (state == NULL) {
+        return false;
+    }
+    uint32_t samples = options.samples > 0 ? options.samples : 1;
+    uint64_t sampleNs = (uint64_t)(options.sampleSeconds * 1e9);
+
+    // grow the sample until it is long enough for the clock resolution
+    uint64_t ops = 1;
+    while (ops < GB_MICRO_BENCH_MAX_OPS && _GBMicroBenchTime(benchCase, state, ops) < sampleNs) {
+        ops *= 2;
+    }
+
+    uint64_t warmupNs = (uint64_t)(options.warmupSeconds * 1e9);
+    uint64_t warmupStart = _GBMicroBenchNanoseconds();
+    while (_GBMicroBenchNanoseconds() - warmupStart < warmupNs) {
+        _GBMicroBenchTime(benchCase, state, ops);
+    }
+
+    double* nsPerOp = malloc(sizeof(double) * samples);
+    if (nsPerOp == NULL) {
+        benchCase->teardown(state);
+        return false;
+    }
+    for (uint32_t i = 0; i < samples; i++) {
+        nsPerOp[i] = (double)_GBMicroBenchTime(benchCase, state, ops) / ops;
+    }
+    benchCase->teardown(state);
+
+    qsort(nsPerOp, samples, sizeof(double), _GBMicroBenchCompareDoubles);
+    result->opsPerSample = ops;
+    result->samples = samples;
+    result->min = nsPerOp[0];
+    result->p10 = GBMicroBenchPercentile(nsPerOp, samples, 10);
+    result->median = GBMicroBenchPercentile(nsPerOp, samples, 50);
+    result->p90 = GBMicroBenchPercentile(nsPerOp, samples, 90);
+    result->max = nsPerOp[samples - 1];
+    free(nsPerOp);
+    return true;
+}
+
+void GBMicroBenchWriteJSONHeader(FILE* out, GBMicroBenchOptions options) {
+    fprintf(out, "{\n");
+    fprintf(out, "  \"samples\": %u,\n", options.samples);
+    fprintf(out, "  \"warmupSeconds\": %g,\n", options.warmupSeconds);
+    fprintf(out, "  \"sampleSeconds\": %g,\n", options.sampleSeconds);
+    fprintf(out, "  \"cases\": [\n");
+}
+
+void GBMicroBenchWriteJSONResult(FILE* out, const GBMicroBenchCase* benchCase, const GBMicroBenchResult* result, bool first) {
+    fprintf(out, "%s    {\"name\": \"%s\", \"unit\": \"%s\", \"opsPerSample\": %llu, "
+            "\"min\": %.3f, \"p10\": %.3f, \"median\": %.3f, \"p90\": %.3f, \"max\": %.3f}",
+            first ? "" : ",\n", benchCase->name, benchCase->unit, (unsigned long long)result->opsPerSample,
+            result->min, result->p10, result->median, result->p90, result->max);
+}
+
+void GBMicroBenchWriteJSONFooter(FILE* out) {
+    fprintf(out, "\n  ]\n");
+    fprintf(out, "}\n");
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Microbenchmarks for the core hot paths.
+//
+// A case builds its own synthetic device (no ROM file) in `setup`, then
+// `run` performs `ops` operations on it. The runner first sizes a sample
+// so that it lasts about `sampleSeconds`, runs samples for
+// `warmupSeconds` to settle caches, branch predictors and clock speed,
+// then times `samples` more. Results are the distribution of ns per
+// operation over those samples: the median is the number to compare,
+// the percentiles show how noisy the host was.
+
+struct GBMicroBenchCase_s {
+    // "<primitive>/<variant>", e.g. "read/wram"
+    const char* name;
+    // what one operation is, e.g. "read" or "1000 cycles"
+    const char* unit;
+    void* (*setup)(uintptr_t parameter);
+    void (*run)(void* state, uint64_t ops);
+    void (*teardown)(void* state);
+    uintptr_t parameter;
+};
+
+typedef struct GBMicroBenchCase_s GBMicroBenchCase;
+
+struct GBMicroBenchOptions_s {
+    uint32_t samples;
+    double warmupSeconds;
+    double sampleSeconds;
+};
+
+typedef struct GBMicroBenchOptions_s GBMicroBenchOptions;
+
+#define GB_MICRO_BENCH_DEFAULT_OPTIONS ((GBMicroBenchOptions){ .samples = 31, .warmupSeconds = 0.1, .sampleSeconds = 0.005 })
+
+// ns per operation
+struct GBMicroBenchResult_s {
+    uint64_t opsPerSample;
+    uint32_t samples;
+    double min;
+    double p10;
+    double median;
+    double p90;
+    double max;
+};
+
+typedef struct GBMicroBenchResult_s GBMicroBenchResult;
+
+extern const GBMicroBenchCase GBMicroBenchCases[];
+extern const uint32_t GBMicroBenchCaseCount;
+
+// Returns false if the case could not be set up
+bool GBMicroBenchRun(const GBMicroBenchCase* benchCase, GBMicroBenchOptions options, GBMicroBenchResult* result);
+// Linear interpolation between the closest ranks of `sorted`
+double GBMicroBenchPercentile(const double* sorted, uint32_t count, double percentile);
+
+// One JSON object per case and line:
+//     {"name": "read/wram", "unit": "read", "median": 2.41, "p10": ..., ...}
+void GBMicroBenchWriteJSONHeader(FILE* out, GBMicroBenchOptions options);
+void GBMicroBenchWriteJSONResult(FILE* out, const GBMicroBenchCase* benchCase, const GBMicroBenchResult* result, bool first);
+void GBMicroBenchWriteJSONFooter(FILE* out);
+
+// Defeats dead code elimination of benchmarked reads
+extern volatile uint64_t GBMicroBenchSink;
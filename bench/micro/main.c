@@ -0,0 +1,96 @@
+#include "MicroBench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void usage(const char* name) {
+    printf("usage: %s [--samples N] [--warmup <seconds>] [--json <out>] [--list] [filter ...]\n"
+           "Runs the cases whose name contains one of the filters (all by default)\n"
+           "and prints ns per operation: median and spread over the samples.\n", name);
+}
+
+static bool matches(const char* name, int filterCount, const char** filters) {
+    if (filterCount == 0) {
+        return true;
+    }
+    for (int i = 0; i < filterCount; i++) {
+        if (strstr(name, filters[i]) != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, const char * argv[]) {
+    GBMicroBenchOptions options = GB_MICRO_BENCH_DEFAULT_OPTIONS;
+    const char* jsonPath = NULL;
+    const char** filters = calloc(argc, sizeof(char*));
+    int filterCount = 0;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--samples") == 0 && hasValue) {
+            options.samples = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--warmup") == 0 && hasValue) {
+            options.warmupSeconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--json") == 0 && hasValue) {
+            jsonPath = argv[++i];
+        } else if (strcmp(argv[i], "--list") == 0) {
+            for (uint32_t c = 0; c < GBMicroBenchCaseCount; c++) {
+                printf("%s\n", GBMicroBenchCases[c].name);
+            }
+            free(filters);
+            return 0;
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            free(filters);
+            return 2;
+        } else {
+            filters[filterCount++] = argv[i];
+        }
+    }
+    options.samples = options.samples > 0 ? options.samples : 1;
+
+    FILE* json = NULL;
+    if (jsonPath != NULL) {
+        json = fopen(jsonPath, "w");
+        if (json == NULL) {
+            printf("⛔️ could not write %s\n", jsonPath);
+            free(filters);
+            return 2;
+        }
+        GBMicroBenchWriteJSONHeader(json, options);
+    }
+
+    printf("%u samples after %.2f s of warmup, ns per operation\n", options.samples, options.warmupSeconds);
+    printf("----------------------------\n");
+    printf("%-24s %-12s %10s %10s %10s %8s\n", "case", "operation", "median", "p10", "p90", "spread");
+    int status = 0;
+    bool first = true;
+    for (uint32_t c = 0; c < GBMicroBenchCaseCount; c++) {
+        const GBMicroBenchCase* benchCase = &GBMicroBenchCases[c];
+        if (matches(benchCase->name, filterCount, filters) == false) {
+            continue;
+        }
+        GBMicroBenchResult result;
+        if (GBMicroBenchRun(benchCase, options, &result) == false) {
+            printf("⛔️ %s could not be set up\n", benchCase->name);
+            status = 1;
+            continue;
+        }
+        double spread = result.median > 0 ? (result.p90 - result.p10) * 100 / result.median : 0;
+        printf("%-24s %-12s %10.2f %10.2f %10.2f %7.1f%%\n", benchCase->name, benchCase->unit,
+               result.median, result.p10, result.p90, spread);
+        fflush(stdout);
+        if (json != NULL) {
+            GBMicroBenchWriteJSONResult(json, benchCase, &result, first);
+        }
+        first = false;
+    }
+    if (json != NULL) {
+        GBMicroBenchWriteJSONFooter(json);
+        fclose(json);
+    }
+    free(filters);
+    return status;
+}
@@ -3,12 +3,12 @@
 #include "core/definitions.h"
 #include <Foundation/NSObjCRuntime.h>
 #import <Foundation/Foundation.h>
-#include <sys/_types/_u_int32_t.h>
 #import <AudioToolbox/AudioToolbox.h>
 #import "core/APU.h"
 #import "core/Device.h"
 
-#define GB_AUDIO_BUFFER_SIZE 0x4000
+// Audio queued ahead of the output device, in seconds
+#define GB_AUDIO_TARGET_LATENCY 0.025
 
 OSStatus render(GBAudioClient *self,
                 AudioUnitRenderActionFlags *ioActionFlags,
@@ -17,12 +17,7 @@ OSStatus render(GBAudioClient *self,
                 UInt32 inNumberFrames,
                 AudioBufferList *ioData);
 
-void _GBOnSampleReadyBack(void* sender, GB_device *device, GBSample sample);
-
-
 @interface GBAudioClient()
-    
--(void) onSampleBlockReady:(GB_device *)device  sample:(GBSample) sample;
 
 -(void) onRenderBlockRequest:(UInt32)sampleRate  nFrame:(UInt32) nFrames buffer: (GBSample *) buffer;
 
@@ -30,16 +25,13 @@ void _GBOnSampleReadyBack(void* sender, GB_device *device, GBSample sample);
 
 @implementation GBAudioClient {
     AudioComponentInstance audioUnit;
-    GBSample _audioBuffer[GB_AUDIO_BUFFER_SIZE];
-    u_int32_t _audioBufferPosition;
-    NSCondition* _lock;
-    UInt32 requestedFrames;
+    GB_device* _device;
 }
 
 -(id)initWithSampleRate:(NSInteger)rate andDevice:(GB_device*) device {
     self = [super init];
 
-    _lock = [[NSCondition alloc] init];
+    _device = device;
 
     AudioComponentDescription defaultOutputDescription;
     defaultOutputDescription.componentType = kAudioUnitType_Output;
@@ -105,44 +97,26 @@ void _GBOnSampleReadyBack(void* sender, GB_device *device, GBSample sample);
     }
 
     self.sampleRate = rate;
-    device->apu->sampleRate = rate;
-    GBApuSetSampleReadyCallback(device, _GBOnSampleReadyBack, (__bridge void *)(self));
+    GBApuSetSampleRate(device, (uint32_t)rate);
+    // keep the core ring around the target latency instead of dropping/padding
+    GBApuSetRateControl(device, (uint32_t)(rate * GB_AUDIO_TARGET_LATENCY), GB_APU_RATE_CONTROL_DELTA);
 
     return self;
 }
 
 -(void) onRenderBlockRequest:(UInt32)sampleRate  nFrame:(UInt32) nFrames buffer: (GBSample *) buffer {
-    [_lock lock];
-    if (_audioBufferPosition < nFrames) {
-        requestedFrames = nFrames;
-        [_lock waitUntilDate:[NSDate dateWithTimeIntervalSinceNow:(double)(requestedFrames - _audioBufferPosition) / sampleRate]];
-        requestedFrames = 0;
+    // Runs on the real-time audio thread: copy out of the core ring, never wait.
+    size_t available = GBApuSamplesAvailable(_device);
+    if (available > nFrames + (sampleRate / 20)) {
+        // too far behind, drop the oldest samples to keep latency bounded
+        GBApuSkipSamples(_device, available - nFrames);
     }
 
-    if (_audioBufferPosition < nFrames) {
+    size_t copied = GBApuReadSamples(_device, buffer, nFrames);
+    if (copied < nFrames) {
         // Not enough audio
-        memset(buffer, 0, (nFrames - _audioBufferPosition) * sizeof(*buffer));
-        memcpy(buffer, _audioBuffer, _audioBufferPosition * sizeof(*buffer));
-        // Do not reset the audio position to avoid more underflows
-    } 
-    else if (_audioBufferPosition < nFrames + (sampleRate / 20)) {
-        memcpy(buffer, _audioBuffer, nFrames * sizeof(*buffer));
-        memmove(_audioBuffer, _audioBuffer + nFrames, (_audioBufferPosition - nFrames) * sizeof(*buffer));
-        _audioBufferPosition = _audioBufferPosition - nFrames;
+        memset(buffer + copied, 0, (nFrames - copied) * sizeof(*buffer));
     }
-    else {
-        memcpy(buffer, _audioBuffer + (_audioBufferPosition - nFrames), nFrames * sizeof(*buffer));
-        _audioBufferPosition = 0;
-    }
-    
-    [_lock unlock];
-}
-
--(void) onSampleBlockReady:(GB_device *)device  sample:(GBSample) sample {
-    [_lock lock];
-    _audioBuffer[_audioBufferPosition] = sample;
-    _audioBufferPosition = (_audioBufferPosition + 1) % GB_AUDIO_BUFFER_SIZE;
-    [_lock unlock];
 }
 
 -(void) start
@@ -177,9 +151,4 @@ OSStatus render(
     return noErr;
 }
 
-void _GBOnSampleReadyBack(void* sender, GB_device *device, GBSample sample) {
-    GBAudioClient* audioClient = (__bridge GBAudioClient *)sender;
-    [audioClient onSampleBlockReady: device sample: sample];
-}
-
 @end
@@ -39,6 +39,22 @@
 
 @implementation GBViewController {
     GB_device *device;
+    char console[100];
+    int consoleLength;
+}
+
+- (void)appendConsoleByte:(Byte)value {
+    console[consoleLength++] = value;
+    if (value == '\n' || consoleLength == sizeof(console) - 1) {
+        NSLog(@"%@", [[NSString alloc] initWithBytes:console length:consoleLength encoding:NSASCIIStringEncoding]);
+        consoleLength = 0;
+    }
+}
+
+// Test ROMs print their progress over the serial port, one line at a time
+static void GBViewControllerSerialByte(void* sender, GB_device* device, Byte value) {
+    GBViewController* controller = (__bridge GBViewController*)sender;
+    [controller appendConsoleByte:value];
 }
 
 -(id)initWithRomFilePath:(NSString *)romFilePath {
@@ -59,6 +75,7 @@
 
     device = GB_newDevice();
     GB_reset(device);
+    GBSerialSetByteCallback(device, GBViewControllerSerialByte, (__bridge void*)self);
 
     NSImageView *imgView = [[NSImageView alloc] init];
     imgView.frame = CGRectMake(0, 0, 256, 256);
@@ -105,26 +122,13 @@
 }
 
 -(void)renderFrame {
-    int strIdx = 0;
-    char console[100];
-    while ((device->mmu->interruptRequest & GB_INTERRUPT_FLAG_VBLANK) == 0) {
+    while ((device->mmu.interruptRequest & GB_INTERRUPT_FLAG_VBLANK) == 0) {
         unsigned char cycles = GB_deviceCpuStep(device);
         GB_devicePPUstep(device, cycles);
-        
-        if(GB_deviceReadByte(device, 0xFF02) == 0x81) {
-            unsigned char sb = GB_deviceReadByte(device, 0xFF01);
-            GB_deviceWriteByte(device, 0xFF02, 0x01);
-            console[strIdx] = sb;
-            strIdx++;
-            if(sb == '\n' || strIdx == 99) {
-                NSLog(@"%@", [NSString stringWithCString:console length:strIdx]);
-                strIdx = 0;
-            }
-        }
     }
     // TODO: Render Frame
     // Frame done
-    device->mmu->interruptRequest &= ~(GB_INTERRUPT_FLAG_VBLANK);
+    device->mmu.interruptRequest &= ~(GB_INTERRUPT_FLAG_VBLANK);
     uint8_t* data =  GB_ppu_gen_background_bitmap(device);
     NSBitmapImageRep* img = [[NSBitmapImageRep alloc] 
         initWithBitmapDataPlanes: &data 
@@ -8,9 +8,6 @@
 #import "GBShaderTypes.h"
 #include "core/Newboy.h"
 
-uint8_t _crc8(uint8_t const *data, size_t nBytes, int start, int stride);
-u_int64_t stepCounter = 0;
-
 
 @implementation GameRenderer
 {
@@ -30,6 +27,7 @@ u_int64_t stepCounter = 0;
     NSUInteger _frameNum;
     id<MTLTexture> _texture;
     GB_device* _gameboydevice;
+    uint64_t _stepCounter;
     GBAudioClient *_audioClient;
     NSString* _romPath;
 }
@@ -71,14 +69,14 @@ u_int64_t stepCounter = 0;
 -(CGImageRef)renderFrame {
     int strIdx = 0;
     char console[100];
-    while (_gameboydevice->ppu->frameReady == false){
+    while (_gameboydevice->ppu.frameReady == false){
         GBUpdateJoypadState(_gameboydevice, self.joypad);
         GB_emulationStep(_gameboydevice);
-        stepCounter++;
+        _stepCounter++;
     }
     // TODO: Render Frame
     // Frame done
-    _gameboydevice->ppu->frameReady = false;
+    _gameboydevice->ppu.frameReady = false;
     uint8_t* data =  GB_ppu_gen_frame_bitmap(_gameboydevice);
     NSBitmapImageRep* img = [[NSBitmapImageRep alloc] 
         initWithBitmapDataPlanes: &data 
@@ -91,7 +89,7 @@ u_int64_t stepCounter = 0;
         bitmapFormat:NSBitmapFormatThirtyTwoBitLittleEndian 
         bytesPerRow:160 * 4
         bitsPerPixel:32];
-    //[self printScreenCRC];
+    //[self printScreenHash];
     
     free(data);
     return [img CGImage];
@@ -100,14 +98,14 @@ u_int64_t stepCounter = 0;
 // -(CGImageRef)renderBackground {
 //     int strIdx = 0;
 //     char console[100];
-//     // if(_gameboydevice->cpu->is_halted == false)
-//     while (_gameboydevice->ppu->frameReady == false){
+//     // if(_gameboydevice->cpu.is_halted == false)
+//     while (_gameboydevice->ppu.frameReady == false){
 //         GBUpdateJoypadState(_gameboydevice, self.joypad);
 //         GB_emulationStep(_gameboydevice);
 //     }
 //     // TODO: Render Frame
 //     // Frame done
-//     _gameboydevice->ppu->frameReady = false;
+//     _gameboydevice->ppu.frameReady = false;
 //     uint8_t* data =  GB_ppu_gen_background_bitmap(_gameboydevice);
 //     NSBitmapImageRep* img = [[NSBitmapImageRep alloc] 
 //         initWithBitmapDataPlanes: &data 
@@ -238,14 +236,9 @@ u_int64_t stepCounter = 0;
     _viewportSize.y = drawableSize.height;
 }
 
--(void)printScreenCRC {
-    uint8_t crc1 = _crc8((uint8_t *)_gameboydevice->ppu->frameBuffer[GBBackgroundFrameBuffer], sizeof(int32_t) * 160 * 144, 0, 1);
-    uint8_t crc2 = _crc8((uint8_t *)_gameboydevice->ppu->frameBuffer[GBBackgroundFrameBuffer], sizeof(int32_t) * 160 * 144, 0, 2);
-    uint8_t crc3 = _crc8((uint8_t *)_gameboydevice->ppu->frameBuffer[GBBackgroundFrameBuffer], sizeof(int32_t) * 160 * 144, 1, 2);
-    uint8_t crc4 = _crc8((uint8_t *)_gameboydevice->ppu->frameBuffer[GBObjectFrameBuffer], sizeof(int32_t) * 160 * 144, 0, 1);
-
-    NSLog(@" CRC: %02x%02x%02x%02x", crc4, crc3, crc2, crc1);
-    NSLog(@"Steps: %llx", stepCounter);
+-(void)printScreenHash {
+    NSLog(@" Frame hash: %016llx", (unsigned long long)GB_frame_hash(_gameboydevice));
+    NSLog(@"Steps: %llx", _stepCounter);
 }
 
 -(void)disposeRessources {
@@ -253,21 +246,3 @@ u_int64_t stepCounter = 0;
 }
 
 @end
-
-uint8_t _crc8(uint8_t const *data, size_t nBytes, int start, int stride) {
-    if (data == NULL) {
-        return 0;
-    }
-    uint8_t coefficient = 0xb2;
-
-    uint8_t remainder = 0;
-    for (int byte = start; byte < nBytes; byte += stride) {
-        remainder ^= data[byte];
-        // Perform modulo-2 division, a bit at a time.
-        for (uint8_t i = 0; i < 8; i++) {
-            // Try to divide the current data bit.
-            remainder = ((remainder & 0x1) != 0) ? (remainder >> 1) ^ coefficient : (remainder >> 1);
-        }
-    }
-    return remainder ^ 0xFF;
-}
\ No newline at end of file
@@ -4,20 +4,26 @@
 #include "Device.h"
 #include "core/definitions.h"
 #include "Helper.h"
+#include "RingBuffer.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include <stdint.h>
 #include <string.h>
 
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
 //#define APU_HZ 1048576
 #define APU_HZ 2097152
 
 bool _GBIsDacOn(GB_device* device, GBSoundChannel channel);
 bool _GBIsMasterAudioOn(GB_device* device, GBSoundChannel channel);
 void _enableChannelIfPossible(GB_device* device, GBSoundChannel channel, Byte value, int regStart, Word lengMax);
-void _extractWaveSample(GB_device* device, bool force);
-u_int16_t _GBChannelPeriod(GB_device* device, int NRx3);
-void _GBWriteChannelPeriod(GB_device* device, int NRx3, u_int16_t value);
+void _GBWaveChannelEvents(GB_device* device);
+uint16_t _GBChannelPeriod(GB_device* device, int NRx3);
+void _GBWriteChannelPeriod(GB_device* device, int NRx3, uint16_t value);
 void _disableChannelIfOff(GB_device* device, GBSoundChannel channel);
 void _GB_updateLengthTimer(GB_device* device, GBSoundChannel channel, int regStart, Word max);
 void _handleLenTrigger(GB_device* device, GBSoundChannel channel, Byte newValue, Byte oldValue, int regStart, Word lengMax);
@@ -28,10 +34,18 @@ void _ch1SweepUpdate(GB_device* device);
 void GBApuReset(GB_device* device);
 void GBApuDMGDown(GB_device* device);
 void _GB_update_LFSR(GB_device* device);
-void _GB_gen_noise_wave(GB_device* device);
+void _GBNoiseChannelEvents(GB_device* device);
+uint32_t _GBNoiseChannelPeriod(GB_device* device);
 void _triggerCh4(GB_device* device, Byte value);
-
-u_int16_t _squareChannelFrequency(GB_device *device, GBSoundChannel channel);
+void _GBApuSetChannelValue(GB_device* device, GBSoundChannel channel, short value, uint32_t clockTime);
+void _GBApuMixOutput(GB_device* device);
+void _GBApuUpdateGains(GB_device* device);
+void _GBApuUpdateRateControl(GB_device* device);
+void _GBApuSetOutputRatio(GB_device* device, double ratio);
+void _GBApuClearOutput(GB_device* device);
+void _GBApuEndFrame(GB_device* device);
+
+uint16_t _squareChannelFrequency(GB_device *device, GBSoundChannel channel);
 void _GBSquareChannelTrigger(GB_device* device, GBSoundChannel channel, Byte value, Byte oldValue);
 
 void _GBChannelTrigger(GB_device* device, GBSoundChannel channel, Byte value, Byte oldValue);
@@ -45,15 +59,18 @@ const Byte _gbSquareDudities[4][8] = {
 };
 
 void GBWriteToAPURegister(GB_device* device, Word addr, Byte value) {
-    GBApu* apu = device->apu;
+    GBApu* apu = &device->apu;
     Word localAddr = (addr & 0xFF) - 0x10; // start at 0xFF10
     //GBprintf("APU: write to address %04x: %02x\n", addr, value);
     if (localAddr >= 0x30) {
         GBprintf("APU: write to address %04x is out of bounds\n", addr);
         return; //Out of bounds
     }
+    if (apu->vgmLog != NULL) {
+        GBVgmLoggerPush(apu->vgmLog, apu->elapsedTicks, localAddr, value);
+    }
 
-    if (device->apu->data[NR52] == 0) {
+    if (device->apu.data[NR52] == 0) {
         //power off make sur we don't write to reg other than NR52
         if (localAddr != NR52) {
             switch (localAddr) {
@@ -73,7 +90,7 @@ void GBWriteToAPURegister(GB_device* device, Word addr, Byte value) {
     if (localAddr >= 0x20) {
         if (false == apu->activeChannels[GBSoundCH3]) {
             apu->data[localAddr] = value;
-        } else if(apu->waveReadclock == device->cpu->divCounter) {
+        } else if(apu->waveReadclock == apu->clock) {
             apu->data[0x20 + apu->channelReaderCursors[GBSoundCH3] / 2] = value;
         }
         
@@ -84,32 +101,36 @@ void GBWriteToAPURegister(GB_device* device, Word addr, Byte value) {
 
     switch (localAddr) {
         case NR10:
-            oldValue = device->apu->data[localAddr];
-            device->apu->data[localAddr] = value;
+            oldValue = device->apu.data[localAddr];
+            device->apu.data[localAddr] = value;
             _ch1SweepNegateExitTrigger(device, value, oldValue);
             break;
         case NR30:
-            device->apu->data[localAddr] = value;
+            device->apu.data[localAddr] = value;
             _disableChannelIfOff(device, localAddr / 0x05);
             break;
         case NR11:case NR21:case NR41:
-            device->apu->data[localAddr] = value;
-            apu->channelLen[localAddr / 0x05] = device->apu->data[localAddr] & 0x3F;
+            device->apu.data[localAddr] = value;
+            apu->channelLen[localAddr / 0x05] = device->apu.data[localAddr] & 0x3F;
             break;
         case NR31:
-            device->apu->data[localAddr] = value;
-            apu->channelLen[localAddr / 0x05] = device->apu->data[localAddr]; 
+            device->apu.data[localAddr] = value;
+            apu->channelLen[localAddr / 0x05] = device->apu.data[localAddr]; 
             break;
         case NR52:
-            device->apu->data[NR52] = value & 0x80;
-            if (device->apu->data[NR52] == 0) {
+            device->apu.data[NR52] = value & 0x80;
+            if (device->apu.data[NR52] == 0) {
                 GBApuDMGDown(device);
                 // TODO: on CGB call APU_RESET instead
                 // GBApuReset(device);
             }
             break;
+        case NR50: case NR51:
+            device->apu.data[localAddr] = value;
+            _GBApuUpdateGains(device);
+            break;
         case NR12: case NR22: case NR42:
-            device->apu->data[localAddr] = value;
+            device->apu.data[localAddr] = value;
             apu->envelopeVolume[localAddr / 0x05] = (value >> 4);
             _disableChannelIfOff(device, localAddr / 0x05);
             break;
@@ -120,14 +141,15 @@ void GBWriteToAPURegister(GB_device* device, Word addr, Byte value) {
             _GBSquareChannelTrigger(device, GBSoundCH1, value, oldValue);
             break;
         case NR24:
+            oldValue = apu->data[NR24];
             _enableChannelIfPossible(device, GBSoundCH2, value, NR20, 0x40);
-            _GBSquareChannelTrigger(device, GBSoundCH1, value, oldValue);
+            _GBSquareChannelTrigger(device, GBSoundCH2, value, oldValue);
             break;
         case NR33:
-            device->apu->data[localAddr] = value;
+            device->apu.data[localAddr] = value;
             break;
         case NR34:
-            oldValue = device->apu->data[localAddr];
+            oldValue = device->apu.data[localAddr];
             _GBCh3Trigger(device, value, oldValue);
             _enableChannelIfPossible(device, GBSoundCH3, value, NR30, 0x100);
             break;
@@ -136,13 +158,14 @@ void GBWriteToAPURegister(GB_device* device, Word addr, Byte value) {
             _triggerCh4(device, value);
             break;
         default:
-            device->apu->data[localAddr] = value;
+            device->apu.data[localAddr] = value;
             break;
     }
+    _GBApuMixOutput(device);
 }
 
 Byte GBReadAPURegister(GB_device* device, Word addr) {
-    GBApu* apu = device->apu;
+    GBApu* apu = &device->apu;
     Word localAddr = (addr & 0xFF) - 0x10;
     if (localAddr >= 0x30) {
         return 0; //Out of bounds
@@ -151,7 +174,7 @@ Byte GBReadAPURegister(GB_device* device, Word addr) {
         // wave read
         if (apu->activeChannels[GBSoundCH3] == false) {
             return apu->data[localAddr];
-        } else if (apu->waveReadclock == device->cpu->divCounter) {
+        } else if (apu->waveReadclock == apu->clock) {
             return apu->waveValue;
         }
         return 0xFF;
@@ -164,7 +187,7 @@ Byte GBReadAPURegister(GB_device* device, Word addr) {
                 (apu->activeChannels[GBSoundCH2] ? 2 : 0) |
                 (apu->activeChannels[GBSoundCH3] ? 4 : 0) |
                 (apu->activeChannels[GBSoundCH4] ? 8 : 0) |
-                ((device->apu->data[NR52] & 0x80) != 0 ? 0x80 : 0);
+                ((device->apu.data[NR52] & 0x80) != 0 ? 0x80 : 0);
             return out;
         case NR10:
             return 0x80 | apu->data[localAddr];
@@ -189,35 +212,35 @@ Byte GBReadAPURegister(GB_device* device, Word addr) {
 
 void _handleLenTrigger(GB_device* device, GBSoundChannel channel, Byte newValue, Byte oldValue, int regStart, Word lengMax) {
     if (((oldValue & 0x40) == 0 && newValue & 0x40)) {
-        if (device->apu->channelLen[channel] != 0 || (oldValue & 0x80)) {
-            if ((device->apu->divApu & 0x01) == 1) {
+        if (device->apu.channelLen[channel] != 0 || (oldValue & 0x80)) {
+            if ((device->apu.divApu & 0x01) == 1) {
                 _GB_updateLengthTimer(device, channel, regStart, lengMax);
             }
         }
     }
-    if ((newValue & 0x80) && device->apu->channelLen[channel] == 0) {
-        if ((device->apu->divApu & 0x01) == 1) {
+    if ((newValue & 0x80) && device->apu.channelLen[channel] == 0) {
+        if ((device->apu.divApu & 0x01) == 1) {
             _GB_updateLengthTimer(device, channel, regStart, lengMax);
         }
     }
 }
 
 void _GBSquareChannelTrigger(GB_device* device, GBSoundChannel channel, Byte value, Byte oldValue) {
-    if ((value & 0x80) == 0 || channel == GBSoundCH3 || GBSoundCH4) {
+    if ((value & 0x80) == 0 || channel == GBSoundCH3 || channel == GBSoundCH4) {
         return;   // not triggered or wrong channel
     }
 
-    device->apu->channelReaderCursors[channel] = 0;
-    device->apu->channelClockDelay[channel] = _squareChannelFrequency(device, channel);
+    device->apu.channelReaderCursors[channel] = 0;
+    device->apu.channelNextEvent[channel] = device->apu.clock + 2 * _squareChannelFrequency(device, channel);
 }
 
 void _GBCh3Trigger(GB_device* device, Byte value, Byte oldValue)  {
     bool dmgCorruptEnabled = true;
     if (value & 0x80) { // triggered
         if (dmgCorruptEnabled == true &&
-            device->apu->activeChannels[GBSoundCH3] == true &&
-            device->apu->channelClockDelay[GBSoundCH3] == 0) {
-            Byte idx = (device->apu->channelReaderCursors[GBSoundCH3] + 1);
+            device->apu.activeChannels[GBSoundCH3] == true &&
+            device->apu.channelNextEvent[GBSoundCH3] == device->apu.clock + 1) {
+            Byte idx = (device->apu.channelReaderCursors[GBSoundCH3] + 1);
             Byte offset = (idx >> 1) & 0xF;
 
             // Source: Sameboy apu.c https://github.com/LIJI32/SameBoy/blob/master/Core/apu.c#L634
@@ -232,21 +255,20 @@ void _GBCh3Trigger(GB_device* device, Byte value, Byte oldValue)  {
                 Additionally, I believe DMGs, including those we behave differently than emulated,
                 are all deterministic. */
             if (offset < 4) {
-                device->apu->data[APU_WAVE_START] = device->apu->data[APU_WAVE_START + offset];
+                device->apu.data[APU_WAVE_START] = device->apu.data[APU_WAVE_START + offset];
             } 
             else {
                 Byte delta = (offset & ~3);
-                memcpy(device->apu->data + APU_WAVE_START,
-                       device->apu->data + APU_WAVE_START + delta,
+                memcpy(device->apu.data + APU_WAVE_START,
+                       device->apu.data + APU_WAVE_START + delta,
                        4);
             }
         }
-        device->apu->channelReaderCursors[GBSoundCH3] = 0;
-        
-        // TODO: refactor
-        u_int16_t period = _GBChannelPeriod(device, NR33);
-        u_int32_t periodValue = 2048 - period;
-        device->apu->channelClockDelay[GBSoundCH3] = periodValue + 2;
+        device->apu.channelReaderCursors[GBSoundCH3] = 0;
+
+        // first sample is read 3 ticks later than a regular period
+        uint32_t periodValue = 2048 - _GBChannelPeriod(device, NR33);
+        device->apu.channelNextEvent[GBSoundCH3] = device->apu.clock + periodValue + 3;
     }
 }
 
@@ -254,27 +276,27 @@ void _ch1SweepTrigger(GB_device* device, GBSoundChannel channel, Byte newValue,
     if (newValue == 0xC0) {
         newValue = newValue;
     }
-    Byte step = device->apu->data[NR10] & 0x7;
-    Byte pace = (device->apu->data[NR10] >> 4) & 0x7;
-    u_int16_t period = _GBChannelPeriod(device, NR13);
+    Byte step = device->apu.data[NR10] & 0x7;
+    Byte pace = (device->apu.data[NR10] >> 4) & 0x7;
+    uint16_t period = _GBChannelPeriod(device, NR13);
 
     if (newValue & 0x80) { // triggered
-        device->apu->ch1SweepEnabled = (pace != 0 || step != 0) ? true : false;
-        device->apu->periodSweepTimer = (pace != 0) ? pace : 8;
-        device->apu->periodOnTrigger = period;
+        device->apu.ch1SweepEnabled = (pace != 0 || step != 0) ? true : false;
+        device->apu.periodSweepTimer = (pace != 0) ? pace : 8;
+        device->apu.periodOnTrigger = period;
         if (step != 0) {
-            _triggerCh1Sweep(device, (device->apu->data[NR10] & 0x8) != 0);
+            _triggerCh1Sweep(device, (device->apu.data[NR10] & 0x8) != 0);
         }
     }
 }
 
 void _ch1SweepUpdate(GB_device* device) {
-    if (device->apu->ch1SweepEnabled == false || false == device->apu->activeChannels[GBSoundCH1]) {
+    if (device->apu.ch1SweepEnabled == false || false == device->apu.activeChannels[GBSoundCH1]) {
         return;
     }
     
-    GBApu* apu = device->apu;
-    Byte pace = (device->apu->data[NR10] >> 4) & 0x7;
+    GBApu* apu = &device->apu;
+    Byte pace = (device->apu.data[NR10] >> 4) & 0x7;
     Byte step = apu->data[NR10] & 0x7;
 
     apu->periodSweepTimer--;
@@ -287,27 +309,27 @@ void _ch1SweepUpdate(GB_device* device) {
                 _triggerCh1Sweep(device, false);
                 apu->ch1StepZero = step == 0;
             } else {
-                device->apu->ch1NegModeUsed = (device->apu->data[NR10] & 0x8) == 0 ? false : true;
+                device->apu.ch1NegModeUsed = (device->apu.data[NR10] & 0x8) == 0 ? false : true;
             }
         }        
     }
 }
 
 void _triggerCh1Sweep(GB_device* device, bool checkOnly) {
-    GBApu* apu = device->apu;
+    GBApu* apu = &device->apu;
     Byte step = apu->data[NR10] & 0x7;
-    Byte pace = (device->apu->data[NR10] >> 4) & 0x7;
+    Byte pace = (device->apu.data[NR10] >> 4) & 0x7;
     
-    u_int16_t periodOnTrigger = apu->periodOnTrigger;
-    device->apu->ch1NegModeUsed = (device->apu->data[NR10] & 0x8) == 0 ? false : true;
+    uint16_t periodOnTrigger = apu->periodOnTrigger;
+    device->apu.ch1NegModeUsed = (device->apu.data[NR10] & 0x8) == 0 ? false : true;
 
-    u_int16_t delta = periodOnTrigger >> step;
+    uint16_t delta = periodOnTrigger >> step;
     if ((apu->data[NR10] & 0x8) != 0) {
         // uses two's complement for substraction
         delta = ~delta + 1;
     }
     
-    u_int16_t newP = periodOnTrigger + delta;
+    uint16_t newP = periodOnTrigger + delta;
     
     if (newP > 0x7FF && (apu->data[NR10] & 0x8) == 0) {
         apu->activeChannels[GBSoundCH1] = false;
@@ -318,25 +340,24 @@ void _triggerCh1Sweep(GB_device* device, bool checkOnly) {
 }
 
 void _enableChannelIfPossible(GB_device* device, GBSoundChannel channel, Byte value, int regStart, Word lengMax) {
-    Byte oldValue = device->apu->data[regStart + 4];
-    device->apu->data[regStart + 4] = value;
+    Byte oldValue = device->apu.data[regStart + 4];
+    device->apu.data[regStart + 4] = value;
     _handleLenTrigger(device, channel, value, oldValue, regStart, lengMax);
 
     if ((value & 0x80) && _GBIsDacOn(device, channel)) {
-        device->apu->activeChannels[channel] = true;
-        device->apu->channelClock[channel] = 0;
-        device->apu->channelSweepPace[channel] = device->apu->data[regStart + 2] & 0x7;
+        device->apu.activeChannels[channel] = true;
+        device->apu.channelSweepPace[channel] = device->apu.data[regStart + 2] & 0x7;
     }
 }
 
 void _disableChannelIfOff(GB_device* device, GBSoundChannel channel) {
     if (_GBIsDacOn(device, channel) == false) {
-        device->apu->activeChannels[channel] = false;
+        device->apu.activeChannels[channel] = false;
     }
 }
 
 bool _GBIsDacOn(GB_device* device, GBSoundChannel channel) {
-    GBApu* apu = device->apu;
+    GBApu* apu = &device->apu;
     switch (channel) {
         case GBSoundCH1:
             return  (apu->data[NR12] & 0xF8) != 0 ? true : false;
@@ -352,7 +373,7 @@ bool _GBIsDacOn(GB_device* device, GBSoundChannel channel) {
 }
 
 bool _GBIsMasterAudioOn(GB_device* device, GBSoundChannel channel) {
-    return (device->apu->data[NR52] & 0x80) != 0 ? true : false;
+    return (device->apu.data[NR52] & 0x80) != 0 ? true : false;
 }
 
 int _GBSquareChannelUpPosition(int duty) {
@@ -370,16 +391,16 @@ int _GBSquareChannelUpPosition(int duty) {
     }
 }
 
-void _extractWaveSample(GB_device* device, bool force) {
-    GBApu* apu = device->apu;
-    if (force == false && apu->activeChannels[GBSoundCH3] == false) {
+void _GBWaveChannelEvents(GB_device* device) {
+    GBApu* apu = &device->apu;
+    if (apu->activeChannels[GBSoundCH3] == false) {
         return;
     }
 
-    Byte sound = (apu->data[NR32] & 0x60) >> 5;
-    sound = sound & 0x3;
- 
-    if (device->apu->channelClockDelay[GBSoundCH3] == 0) {
+    while ((int32_t)(apu->channelNextEvent[GBSoundCH3] - apu->clock) <= 0) {
+        uint32_t eventClock = apu->channelNextEvent[GBSoundCH3];
+        Byte sound = (apu->data[NR32] & 0x60) >> 5;
+
         apu->channelReaderCursors[GBSoundCH3] = (apu->channelReaderCursors[GBSoundCH3] + 1) % 32;
         int index = apu->channelReaderCursors[GBSoundCH3] / 2;
         Byte sampleValue = apu->data[APU_WAVE_START + index];
@@ -390,92 +411,76 @@ void _extractWaveSample(GB_device* device, bool force) {
         } else {
             sampleValue = sampleValue >> 4;
         }
-        
+
         if(sound > 1) {
             sampleValue = sampleValue >> (sound - 1);
         } else if(sound == 0) {
             sampleValue = 0;
         }
 
-        apu->channelValues[GBSoundCH3] = sampleValue;
-        apu->waveReadclock = device->cpu->divCounter;
-        // TODO: refactor
-        u_int16_t period = _GBChannelPeriod(device, NR33);
-        u_int32_t periodValue = 2048 - period; 
-        apu->channelClockDelay[GBSoundCH3] = periodValue - 1;
-    } else {
-        device->apu->channelClockDelay[GBSoundCH3]--;
-        apu->waveReadclock = 0;
+        _GBApuSetChannelValue(device, GBSoundCH3, sampleValue, eventClock);
+        apu->waveReadclock = eventClock;
+        apu->channelNextEvent[GBSoundCH3] = eventClock + (2048 - _GBChannelPeriod(device, NR33));
     }
 }
 
-u_int16_t _squareChannelFrequency(GB_device *device, GBSoundChannel channel) {
+uint16_t _squareChannelFrequency(GB_device *device, GBSoundChannel channel) {
     int nrx3 = NR13 + (channel * 5);
-    u_int16_t period = _GBChannelPeriod(device, nrx3);
+    uint16_t period = _GBChannelPeriod(device, nrx3);
     return (2048 - period);
 }
 
-u_int16_t _channelFrequency(GB_device *device, GBSoundChannel channel, int regStart) {
-    u_int16_t period = _GBChannelPeriod(device, regStart + 3);
+uint16_t _channelFrequency(GB_device *device, GBSoundChannel channel, int regStart) {
+    uint16_t period = _GBChannelPeriod(device, regStart + 3);
     return 131072 / (2048 - period);
 }
 
-u_int16_t _GBChannelPeriod(GB_device* device, int NRx3) {
-    u_int16_t period =  (device->apu->data[NRx3 + 1] & 0x07) << 8 | device->apu->data[NRx3];
+uint16_t _GBChannelPeriod(GB_device* device, int NRx3) {
+    uint16_t period =  (device->apu.data[NRx3 + 1] & 0x07) << 8 | device->apu.data[NRx3];
     return period;
 }
 
-void _updateSquareWave(GB_device* device, GBSoundChannel channel, int registerStart) {
-    GBApu* apu = device->apu;
-
+void _GBSquareChannelEvents(GB_device* device, GBSoundChannel channel, int registerStart) {
+    GBApu* apu = &device->apu;
     if (false == apu->activeChannels[channel]) {
-        apu->channelValues[channel] = 0;
         return;
     }
 
-    if (apu->channelClockDelay[channel] == 0) {
+    // one duty step every 2 * (2048 - period) ticks
+    while ((int32_t)(apu->channelNextEvent[channel] - apu->clock) <= 0) {
+        uint32_t eventClock = apu->channelNextEvent[channel];
         int duty = apu->data[registerStart + 1] >> 6;
         int cursor = apu->channelReaderCursors[channel];
-        apu->channelValues[channel] = _gbSquareDudities[duty][cursor] * apu->envelopeVolume[channel];
+        _GBApuSetChannelValue(device, channel, _gbSquareDudities[duty][cursor] * apu->envelopeVolume[channel], eventClock);
         apu->channelReaderCursors[channel] = (cursor + 1) % 8;
-
-        device->apu->channelClockDelay[channel] = _squareChannelFrequency(device, channel);
-    } else {
-        apu->channelClockDelay[channel]--;
+        apu->channelNextEvent[channel] = eventClock + 2 * _squareChannelFrequency(device, channel);
     }
 }
 
-void _GB_gen_noise_wave(GB_device* device) {
-    GBApu* apu = device->apu;
+uint32_t _GBNoiseChannelPeriod(GB_device* device) {
+    // LFSR is clocked at 262144 / (divider * 2^shift) Hz, divider 0 counting as 0.5
+    Byte lfsrDivider = device->apu.data[NR43] & 0x7;
+    Byte lfsrShift = (device->apu.data[NR43] >> 4) & 0xF;
+    uint32_t period = (lfsrDivider == 0) ? 4 : 8 * lfsrDivider;
+    return period << lfsrShift;
+}
 
+void _GBNoiseChannelEvents(GB_device* device) {
+    GBApu* apu = &device->apu;
     if (false == apu->activeChannels[GBSoundCH4]) {
-        apu->channelValues[GBSoundCH4] = 0;
         return;
     }
 
-    Byte lfsrDivider = apu->data[NR43] & 0x7;
-    Byte lfsrShift = (apu->data[NR43] >> 4) & 0xF;
-    double divider = (double) lfsrDivider;
-    if (lfsrDivider == 0) {
-        divider = 0.5;
-    }
-
-    u_int32_t chFreq = (0x40000 / divider) / (2 << lfsrShift);
-
-    double freq = (double) chFreq;
-
-    double sampleLength = APU_HZ /(double)freq;
-    double time = apu->clock / (double)freq;
-
-    if (apu->channelClock[GBSoundCH4] % (int)sampleLength == 0) {
+    while ((int32_t)(apu->channelNextEvent[GBSoundCH4] - apu->clock) <= 0) {
+        uint32_t eventClock = apu->channelNextEvent[GBSoundCH4];
         _GB_update_LFSR(device);
-        double volume = (double) apu->envelopeVolume[GBSoundCH4] / 0xF;
-        device->apu->channelValues[GBSoundCH4] = (apu->lfsrState & 0x1) * volume * 0xF;
+        _GBApuSetChannelValue(device, GBSoundCH4, (apu->lfsrState & 0x1) * apu->envelopeVolume[GBSoundCH4], eventClock);
+        apu->channelNextEvent[GBSoundCH4] = eventClock + _GBNoiseChannelPeriod(device);
     }
 }
 
 void _genSquareWaveSample(GB_device* device, double freq) {
-    GBApu* apu = device->apu;
+    GBApu* apu = &device->apu;
 
     double sampleLength = APU_HZ / freq;
     double time = apu->clock / freq;
@@ -488,7 +493,7 @@ void _genSquareWaveSample(GB_device* device, double freq) {
 }
 
 void _genSinWaveSample(GB_device* device, double freq) {
-    GBApu* apu = device->apu;
+    GBApu* apu = &device->apu;
 
     double frq = APU_HZ / freq;
     double time = (apu->clock) / frq;
@@ -498,7 +503,7 @@ void _genSinWaveSample(GB_device* device, double freq) {
 }
 
 void _GB_updateLengthTimer(GB_device* device, GBSoundChannel channel, int regStart, Word max) {
-    GBApu* apu = device->apu;
+    GBApu* apu = &device->apu;
     if (apu->data[regStart + 4] & 0x40) {
         apu->channelLen[channel] = (apu->channelLen[channel] + 1) % max;
         if (apu->channelLen[channel] == 0) {
@@ -508,8 +513,8 @@ void _GB_updateLengthTimer(GB_device* device, GBSoundChannel channel, int regSta
 }
 
 void _gb_update_envelop_pace(GB_device* device, GBSoundChannel channel, int regStart) {
-    GBApu* apu = device->apu;
-    if (device->apu->activeChannels[channel] == false) {
+    GBApu* apu = &device->apu;
+    if (device->apu.activeChannels[channel] == false) {
         return;
     }
 
@@ -528,7 +533,7 @@ void _gb_update_envelop_pace(GB_device* device, GBSoundChannel channel, int regS
 }
 
 void GBApuDiv(GB_device* device) {
-    GBApu* apu = device->apu;
+    GBApu* apu = &device->apu;
     if ((apu->data[NR52] & 0x80) == 0) {
         return; // APU off
     }
@@ -557,152 +562,520 @@ void GBApuDiv(GB_device* device) {
             apu->activeChannels[ch] = false;
         }
     }
+    _GBApuMixOutput(device);
 }
 
 void _triggerCh4(GB_device* device, Byte value) {
-    if ((value & 0x80) == 0 || _GBIsDacOn(device, GBSoundCH4)) {
+    if ((value & 0x80) == 0) {
         return;
     }
-    GBApu *apu = device->apu;
+    GBApu *apu = &device->apu;
     apu->lfsrState = 0;
+    apu->channelNextEvent[GBSoundCH4] = apu->clock + _GBNoiseChannelPeriod(device);
 }
 
-void _GBWriteChannelPeriod(GB_device* device, int NRx3, u_int16_t value) {
-    device->apu->data[NRx3] = value & 0xFF;
-    device->apu->data[NRx3 + 1] = (device->apu->data[NRx3 + 1] & 0xF8) | ((value >> 8) & 0x07);
+void _GBWriteChannelPeriod(GB_device* device, int NRx3, uint16_t value) {
+    device->apu.data[NRx3] = value & 0xFF;
+    device->apu.data[NRx3 + 1] = (device->apu.data[NRx3 + 1] & 0xF8) | ((value >> 8) & 0x07);
 }
 
-GBSample highPass(GB_device *device, GBSample sample) {
-    GBApu *apu = device->apu;
-    double cutoff_frequency = 1.0;
-    double gain = 0.5;//cutoff_frequency / (2 * M_PI * device->apu->sampleRate);
+void _GBApuSetChannelValue(GB_device* device, GBSoundChannel channel, short value, uint32_t clockTime) {
+    GBApu* apu = &device->apu;
+    short delta = value - apu->channelValues[channel];
+    if (delta == 0) {
+        return;
+    }
+    apu->channelValues[channel] = value;
+    if (apu->sampleRate == 0 || apu->audioMode == GBApuAudioModeHeadless) {
+        return; // no host output configured
+    }
+
+    // events of the current step are at most `frameTicks` ticks in the past
+    uint32_t elapsed = apu->clock - clockTime;
+    uint32_t time = elapsed > apu->frameTicks ? 0 : apu->frameTicks - elapsed;
+    if (apu->gainLeft[channel] != 0) {
+        GBBlipAddDelta(&apu->blipSynth, &apu->blipLeft, time, delta * apu->gainLeft[channel]);
+        apu->outputLevel.left += delta * apu->gainLeft[channel];
+    }
+    if (apu->gainRight[channel] != 0) {
+        GBBlipAddDelta(&apu->blipSynth, &apu->blipRight, time, delta * apu->gainRight[channel]);
+        apu->outputLevel.right += delta * apu->gainRight[channel];
+    }
+    if (apu->stems != NULL) {
+        GBBlipAddDelta(&apu->blipSynth, &apu->stems->blip[channel], time, delta * 0x100);
+        apu->stems->level[channel] += delta * 0x100;
+    }
+}
 
-    GBSample output = { 
-        (sample.left) + gain * (apu->lastSampleOutput.left - sample.left),
-        (sample.right) + gain * (apu->lastSampleOutput.right - sample.right) 
+// Emit a band-limited step for every change of the mixed output level
+void _GBApuMixOutput(GB_device* device) {
+    GBApu* apu = &device->apu;
+    if (apu->sampleRate == 0 || apu->audioMode == GBApuAudioModeHeadless) {
+        return; // no host output configured
+    }
+
+    GBApuLanes values = apu->channelValues * apu->activeChannels;
+    GBApuLanes left = values * apu->gainLeft;
+    GBApuLanes right = values * apu->gainRight;
+    GBSample level = {
+        left[0] + left[1] + left[2] + left[3],
+        right[0] + right[1] + right[2] + right[3]
     };
-    apu->lastSample = sample;
-    apu->lastSampleOutput = output;
-    return output;
+
+    if (level.left != apu->outputLevel.left) {
+        GBBlipAddDelta(&apu->blipSynth, &apu->blipLeft, apu->frameTicks, level.left - apu->outputLevel.left);
+    }
+    if (level.right != apu->outputLevel.right) {
+        GBBlipAddDelta(&apu->blipSynth, &apu->blipRight, apu->frameTicks, level.right - apu->outputLevel.right);
+    }
+    apu->outputLevel = level;
+
+    if (apu->stems == NULL) {
+        return;
+    }
+    for (int ch = 0; ch < GBSoundChannelCount; ch++) {
+        short stemLevel = values[ch] * 0x100;
+        if (stemLevel != apu->stems->level[ch]) {
+            GBBlipAddDelta(&apu->blipSynth, &apu->stems->blip[ch], apu->frameTicks, stemLevel - apu->stems->level[ch]);
+            apu->stems->level[ch] = stemLevel;
+        }
+    }
+}
+
+// Per channel output gains: NR51 routes a channel to a side, NR50 sets the
+// side volume (0-7, as 1/8 to 8/8). At full volume a channel unit is 0x100.
+void _GBApuUpdateGains(GB_device* device) {
+    GBApu* apu = &device->apu;
+    Byte panning = apu->data[NR51];
+    int32_t volumeLeft = (((apu->data[NR50] >> 4) & 0x7) + 1) * 0x20;
+    int32_t volumeRight = ((apu->data[NR50] & 0x7) + 1) * 0x20;
+
+    GBApuLanes routeLeft = {panning & 0x01, (panning >> 1) & 0x01, (panning >> 2) & 0x01, (panning >> 3) & 0x01};
+    GBApuLanes routeRight = {(panning >> 4) & 0x01, (panning >> 5) & 0x01, (panning >> 6) & 0x01, (panning >> 7) & 0x01};
+    apu->gainLeft = routeLeft * volumeLeft;
+    apu->gainRight = routeRight * volumeRight;
+}
+
+void _GBApuSetOutputRatio(GB_device* device, double ratio) {
+    GBApu* apu = &device->apu;
+    apu->rateControlRatio = ratio;
+    GBBlipSetRates(&apu->blipLeft, APU_HZ, apu->sampleRate * ratio);
+    GBBlipSetRates(&apu->blipRight, APU_HZ, apu->sampleRate * ratio);
+    if (apu->stems != NULL) {
+        for (int ch = 0; ch < GBSoundChannelCount; ch++) {
+            GBBlipSetRates(&apu->stems->blip[ch], APU_HZ, apu->sampleRate * ratio);
+        }
+    }
+}
+
+// Restart the band-limited output from silence, then remix the current levels
+void _GBApuClearOutput(GB_device* device) {
+    GBApu* apu = &device->apu;
+    apu->frameTicks = 0;
+    apu->outputLevel = (GBSample){0, 0};
+    GBBlipClear(&apu->blipLeft);
+    GBBlipClear(&apu->blipRight);
+    if (apu->stems != NULL) {
+        for (int ch = 0; ch < GBSoundChannelCount; ch++) {
+            GBBlipClear(&apu->stems->blip[ch]);
+            apu->stems->level[ch] = 0;
+        }
+    }
+    _GBApuMixOutput(device);
+}
+
+// Dynamic rate control: the emulation is paced by the video, so the number of
+// samples it produces per host second drifts a little from the sample rate.
+// Scale the resampling ratio by at most `rateControlMaxDelta` depending on how
+// far the ring fill is from its target, which is small enough to be inaudible.
+void _GBApuUpdateRateControl(GB_device* device) {
+    GBApu* apu = &device->apu;
+    if (apu->rateControlTarget == 0) {
+        return;
+    }
+
+    double fill = GBRingBufferReadAvailable(apu->output);
+    double deviation = (apu->rateControlTarget - fill) / apu->rateControlTarget;
+    if (deviation > 1) {
+        deviation = 1;
+    } else if (deviation < -1) {
+        deviation = -1;
+    }
+
+    double ratio = 1 + apu->rateControlMaxDelta * deviation;
+    if (ratio == apu->rateControlRatio) {
+        return;
+    }
+    // only done between frames, where no delta is pending at the old ratio
+    _GBApuSetOutputRatio(device, ratio);
+}
+
+void _GBApuEndFrame(GB_device* device) {
+    GBApu* apu = &device->apu;
+    if (apu->sampleRate == 0 || apu->output == NULL) {
+        apu->frameTicks = 0;
+        return;
+    }
+
+    uint32_t frameTicks = apu->frameTicks;
+    GBBlipEndFrame(&apu->blipLeft, frameTicks);
+    GBBlipEndFrame(&apu->blipRight, frameTicks);
+    apu->frameTicks = 0;
+
+    // When the consumer falls behind the newest samples are dropped
+    GBSample samples[GB_BLIP_BUFFER_SIZE];
+    int count = GBBlipReadSamples(&apu->blipLeft, &samples[0].left, GB_BLIP_BUFFER_SIZE, 2);
+    GBBlipReadSamples(&apu->blipRight, &samples[0].right, count, 2);
+    GBRingBufferWrite(apu->output, samples, count);
+    if (apu->recorder != NULL) {
+        GBAudioRecorderPush(apu->recorder, samples, count);
+    }
+    if (apu->stems != NULL) {
+        int16_t stem[GB_BLIP_BUFFER_SIZE];
+        for (int ch = 0; ch < GBSoundChannelCount; ch++) {
+            GBBlipEndFrame(&apu->stems->blip[ch], frameTicks);
+            int stemCount = GBBlipReadSamples(&apu->stems->blip[ch], stem, GB_BLIP_BUFFER_SIZE, 1);
+            GBRingBufferWrite(apu->stems->output[ch], stem, stemCount);
+        }
+    }
+    _GBApuUpdateRateControl(device);
+
+    if (apu->sampleBlockCallback == NULL) {
+        return;
+    }
+    size_t available = GBRingBufferReadAvailable(apu->output);
+    if (available >= apu->sampleBlockFrames) {
+        apu->sampleBlockCallback(apu->sampleBlockCallbackSender, device, available);
+    }
 }
 
 void GBApuStep(GB_device* device, Byte cycles) {
     Byte ticks = cycles / 2;
+    GBApu* apu = &device->apu;
+    apu->elapsedTicks += ticks;
+
+    if (apu->audioMode == GBApuAudioModeHeadless) {
+        if (apu->data[NR52] & 0x80) {
+            // CH3 still steps: wave RAM reads depend on its exact fetch timing
+            apu->clock += ticks;
+            _GBWaveChannelEvents(device);
+        }
+        return;
+    }
 
-    if((device->apu->data[NR52] & 0x80) == 0) { // master audio disabled
+    if((apu->data[NR52] & 0x80) == 0) { // master audio disabled, keep the output stream going
+        apu->frameTicks += ticks;
+        if (apu->frameTicks >= GB_APU_FRAME_TICKS) {
+            _GBApuEndFrame(device);
+        }
         return;
     }
 
-    u_int32_t cyclesPerSample = 1;
-    GBApu* apu = device->apu;
-    if(device->apu->sampleRate != 0) {
-        cyclesPerSample = APU_HZ / device->apu->sampleRate;
+    // channels only do work when their next transition is reached, one
+    // compare over the lanes tells whether any of them did
+    apu->clock += ticks;
+    apu->frameTicks += ticks;
+    GBApuLanes due = ((GBApuLanes)(apu->channelNextEvent - apu->clock) <= 0) & apu->activeChannels;
+    if ((due[0] | due[1] | due[2] | due[3]) != 0) {
+        _GBSquareChannelEvents(device, GBSoundCH1, NR10);
+        _GBSquareChannelEvents(device, GBSoundCH2, NR20);
+        _GBWaveChannelEvents(device);
+        _GBNoiseChannelEvents(device);
     }
-    
-    for (int i = 0; i < ticks; i++) {
-        device->apu->clock++;
-        GBSample sample = {0};
 
-        if (i % 2 == 0) {
-            _updateSquareWave(device, GBSoundCH1, NR10);
-            _updateSquareWave(device, GBSoundCH2, NR20);
-        }
+    if (apu->frameTicks >= GB_APU_FRAME_TICKS) {
+        _GBApuEndFrame(device);
+    }
+}
 
-        _extractWaveSample(device, false);
-        _GB_gen_noise_wave(device);
+void GBApuSetSampleRate(GB_device* device, uint32_t sampleRate) {
+    GBApu* apu = &device->apu;
+    if (apu->recorder != NULL && apu->sampleRate != sampleRate) {
+        GBApuStopRecording(device); // the file header is tied to the old rate
+    }
+    apu->sampleRate = sampleRate;
+    apu->frameTicks = 0;
+    apu->outputLevel = (GBSample){0, 0};
+    if (sampleRate == 0) {
+        GBApuSetStemsEnabled(device, false);
+        return;
+    }
 
+    GBBlipSynthInit(&apu->blipSynth);
+    _GBApuSetOutputRatio(device, 1);
+    if (apu->output == NULL) {
+        apu->output = GBRingBufferCreate(GB_APU_RING_FRAMES, sizeof(GBSample));
+    } else {
+        GBRingBufferReset(apu->output);
+    }
+    if (apu->stems != NULL) {
         for (int ch = 0; ch < GBSoundChannelCount; ch++) {
+            GBRingBufferReset(apu->stems->output[ch]);
+        }
+    }
+    _GBApuClearOutput(device);
+}
 
-            if (false == apu->activeChannels[ch]) {
-                continue;
-            }
-            if (apu->data[NR51] & (0x01 << ch)) {
-                sample.left += apu->channelValues[ch];
-            }
-            if (apu->data[NR51] & (0x10 << ch)) { 
-                sample.right += apu->channelValues[ch];
-            }
-            if (apu->activeChannels[ch]) {
-                device->apu->channelClock[ch] += 1;
+bool GBApuStartVgmLog(GB_device* device, const char* path) {
+    GBApu* apu = &device->apu;
+    GBApuStopVgmLog(device);
+    GBVgmLogger* log = GBVgmLoggerOpen(path, APU_HZ, apu->elapsedTicks);
+    if (log == NULL) {
+        return false;
+    }
+
+    // replay the current state so the log does not depend on what came before,
+    // without the trigger bits which would restart the channels
+    GBVgmLoggerPush(log, apu->elapsedTicks, NR52, apu->data[NR52] & 0x80);
+    if (apu->data[NR52] & 0x80) {
+        for (int reg = APU_WAVE_START; reg < APU_WAVE_START + 0x10; reg++) {
+            GBVgmLoggerPush(log, apu->elapsedTicks, reg, apu->data[reg]);
+        }
+        for (int reg = NR10; reg <= NR51; reg++) {
+            Byte value = apu->data[reg];
+            if (reg == NR14 || reg == NR24 || reg == NR34 || reg == NR44) {
+                value &= 0x7F;
             }
+            GBVgmLoggerPush(log, apu->elapsedTicks, reg, value);
         }
+    }
+    apu->vgmLog = log;
+    return true;
+}
 
-        sample.left *= 0x100;
-        sample.right *= 0x100;
+bool GBApuStopVgmLog(GB_device* device) {
+    GBApu* apu = &device->apu;
+    if (apu->vgmLog == NULL) {
+        return true;
+    }
+    bool success = GBVgmLoggerClose(apu->vgmLog, apu->elapsedTicks);
+    apu->vgmLog = NULL;
+    return success;
+}
 
-        if(device->apu->clock % cyclesPerSample == 0) {
-            //GBSample out = sample;
-            GBSample out = highPass(device, sample);
-            if (apu->sampleReadyCallback != NULL) {
-                apu->sampleReadyCallback(apu->sampleReadyCallbackSender ,device, out);
+bool GBApuSetStemsEnabled(GB_device* device, bool enabled) {
+    GBApu* apu = &device->apu;
+    if (enabled == false) {
+        if (apu->stems != NULL) {
+            for (int ch = 0; ch < GBSoundChannelCount; ch++) {
+                GBRingBufferFree(apu->stems->output[ch]);
             }
+            free(apu->stems);
+            apu->stems = NULL;
         }
+        return true;
+    }
+    if (apu->stems != NULL) {
+        return true;
     }
+    if (apu->sampleRate == 0) {
+        GBprintf("APU: stems need a sample rate\n");
+        return false;
+    }
+
+    // everything is allocated here so the emulation loop never allocates
+    GBApuStems* stems = malloc(sizeof(GBApuStems));
+    if (stems == NULL) {
+        return false;
+    }
+    memset(stems, 0, sizeof(GBApuStems));
+    for (int ch = 0; ch < GBSoundChannelCount; ch++) {
+        stems->output[ch] = GBRingBufferCreate(GB_APU_RING_FRAMES, sizeof(int16_t));
+        if (stems->output[ch] == NULL) {
+            for (int i = 0; i < ch; i++) {
+                GBRingBufferFree(stems->output[i]);
+            }
+            free(stems);
+            return false;
+        }
+    }
+    // stems start at a frame boundary, sharing the mix sub-sample offset so
+    // their samples stay aligned with the stereo output
+    if (apu->frameTicks != 0) {
+        _GBApuEndFrame(device);
+    }
+    for (int ch = 0; ch < GBSoundChannelCount; ch++) {
+        stems->blip[ch].offset = apu->blipLeft.offset;
+    }
+    apu->stems = stems;
+    _GBApuSetOutputRatio(device, apu->rateControlRatio);
+    _GBApuMixOutput(device);
+    return true;
 }
 
-void GBApuSetSampleReadyCallback(GB_device* device, GBApuSampleReady callback, void* sender) {
-    device->apu->sampleReadyCallback = callback;
-    device->apu->sampleReadyCallbackSender = sender;
+size_t GBApuStemSamplesAvailable(GB_device* device, GBSoundChannel channel) {
+    if (device->apu.stems == NULL || channel >= GBSoundChannelCount) {
+        return 0;
+    }
+    return GBRingBufferReadAvailable(device->apu.stems->output[channel]);
+}
+
+size_t GBApuReadStemSamples(GB_device* device, GBSoundChannel channel, int16_t* buffer, size_t maxFrames) {
+    if (device->apu.stems == NULL || channel >= GBSoundChannelCount) {
+        return 0;
+    }
+    return GBRingBufferRead(device->apu.stems->output[channel], buffer, (uint32_t)maxFrames);
+}
+
+bool GBApuStartRecording(GB_device* device, const char* path, GBAudioRecorderFormat format) {
+    GBApu* apu = &device->apu;
+    if (apu->sampleRate == 0 || apu->audioMode == GBApuAudioModeHeadless) {
+        GBprintf("APU: recording needs a sample rate and full audio mode\n");
+        return false;
+    }
+    GBApuStopRecording(device);
+    apu->recorder = GBAudioRecorderOpen(path, format, apu->sampleRate);
+    return apu->recorder != NULL;
+}
+
+bool GBApuStopRecording(GB_device* device) {
+    GBApu* apu = &device->apu;
+    if (apu->recorder == NULL) {
+        return true;
+    }
+    bool success = GBAudioRecorderClose(apu->recorder);
+    apu->recorder = NULL;
+    return success;
+}
+
+void GBApuResyncOutput(GB_device* device, bool restartGenerators) {
+    GBApu* apu = &device->apu;
+    _GBApuUpdateGains(device);
+    if (apu->audioMode == GBApuAudioModeHeadless) {
+        return;
+    }
+
+    if (restartGenerators) {
+        apu->channelNextEvent[GBSoundCH1] = apu->clock + 2 * _squareChannelFrequency(device, GBSoundCH1);
+        apu->channelNextEvent[GBSoundCH2] = apu->clock + 2 * _squareChannelFrequency(device, GBSoundCH2);
+        apu->channelNextEvent[GBSoundCH4] = apu->clock + _GBNoiseChannelPeriod(device);
+    }
+    if (apu->sampleRate != 0) {
+        _GBApuClearOutput(device);
+    }
+}
+
+void GBApuSetAudioMode(GB_device* device, GBApuAudioMode mode) {
+    GBApu* apu = &device->apu;
+    if (apu->audioMode == mode) {
+        return;
+    }
+    apu->audioMode = mode;
+    if (mode == GBApuAudioModeHeadless) {
+        return;
+    }
+
+    // square and noise generators were not stepped, restart them from now
+    apu->channelNextEvent[GBSoundCH1] = apu->clock + 2 * _squareChannelFrequency(device, GBSoundCH1);
+    apu->channelNextEvent[GBSoundCH2] = apu->clock + 2 * _squareChannelFrequency(device, GBSoundCH2);
+    apu->channelNextEvent[GBSoundCH4] = apu->clock + _GBNoiseChannelPeriod(device);
+    apu->frameTicks = 0;
+    if (apu->sampleRate != 0) {
+        _GBApuClearOutput(device);
+    }
+}
+
+void GBApuSetRateControl(GB_device* device, uint32_t targetFrames, double maxDelta) {
+    GBApu* apu = &device->apu;
+    if (targetFrames > GB_APU_RING_FRAMES / 2) {
+        targetFrames = GB_APU_RING_FRAMES / 2;
+    }
+    apu->rateControlTarget = targetFrames;
+    apu->rateControlMaxDelta = maxDelta > 0 ? maxDelta : GB_APU_RATE_CONTROL_DELTA;
+    if (targetFrames == 0 && apu->sampleRate != 0) {
+        _GBApuSetOutputRatio(device, 1);
+    }
+}
+
+void GBApuSetSampleBlockCallback(GB_device* device, GBApuSampleBlockReady callback, uint32_t blockFrames, void* sender) {
+    if (blockFrames == 0 || blockFrames > GB_APU_RING_FRAMES) {
+        blockFrames = GB_APU_RING_FRAMES;
+    }
+    device->apu.sampleBlockCallback = callback;
+    device->apu.sampleBlockCallbackSender = sender;
+    device->apu.sampleBlockFrames = blockFrames;
+}
+
+size_t GBApuSamplesAvailable(GB_device* device) {
+    if (device->apu.output == NULL) {
+        return 0;
+    }
+    return GBRingBufferReadAvailable(device->apu.output);
+}
+
+size_t GBApuReadSamples(GB_device* device, GBSample* buffer, size_t maxFrames) {
+    if (device->apu.output == NULL) {
+        return 0;
+    }
+    return GBRingBufferRead(device->apu.output, buffer, maxFrames > UINT32_MAX ? UINT32_MAX : (uint32_t)maxFrames);
+}
+
+size_t GBApuSkipSamples(GB_device* device, size_t frames) {
+    if (device->apu.output == NULL) {
+        return 0;
+    }
+    return GBRingBufferSkip(device->apu.output, frames > UINT32_MAX ? UINT32_MAX : (uint32_t)frames);
 }
 
 void _ch1SweepNegateExitTrigger(GB_device* device, Byte newValue, Byte oldValue) {
     if ((newValue & 0x8) != 0 || (oldValue & 0x8) == 0) {
-        device->apu->ch1NegModeUsed = false;
+        device->apu.ch1NegModeUsed = false;
         return;
     }
-    if ((device->apu->divApu % 0x3) == 0x0 || device->apu->ch1NegModeUsed == true) {
-        device->apu->activeChannels[GBSoundCH1] = false;
+    if ((device->apu.divApu % 0x3) == 0x0 || device->apu.ch1NegModeUsed == true) {
+        device->apu.activeChannels[GBSoundCH1] = false;
     }
-    device->apu->ch1NegModeUsed = false;
+    device->apu.ch1NegModeUsed = false;
 }
 
 void GBApuDMGDown(GB_device* device) {
-    GBApu* apu = device->apu;
+    GBApu* apu = &device->apu;
     apu->clock = 0;
-    apu->sampleRate = 0;
+    apu->waveReadclock = apu->clock - 1; // no wave read on the current tick
     apu->periodOnTrigger = 0;
     apu->ch1SweepEnabled = false;
     apu->ch1NegModeUsed = false;
     apu->divApu = 0;
 
     apu->periodSweepTimer = 0;
-    memset(apu->envelopeSweepTimer, 0, GBSoundChannelCount);
-    memset(apu->envelopeVolume, 0, GBSoundChannelCount);
-    memset(apu->activeChannels, false, GBSoundChannelCount);
-    memset(apu->channelValues, 0, GBSoundChannelCount);
+    apu->envelopeSweepTimer = (GBApuLanes){0};
+    apu->envelopeVolume = (GBApuLanes){0};
+    apu->activeChannels = (GBApuLanes){0};
+    apu->channelValues = (GBApuLanes){0};
     memset(apu->data, 0, 0x20);
-    memset(apu->channelReaderCursors, 0, GBSoundChannelCount);
+    apu->channelReaderCursors = (GBApuLanes){0};
+    _GBApuUpdateGains(device);
 }
 
 void GBApuReset(GB_device* device) {
-    GBApu* apu = device->apu;
+    GBApu* apu = &device->apu;
     apu->clock = 0;
-    apu->sampleRate = 0;
+    apu->waveReadclock = apu->clock - 1; // no wave read on the current tick
     apu->periodOnTrigger = 0;
     apu->ch1SweepEnabled = false;
     apu->ch1NegModeUsed = false;
     apu->divApu = 0;
 
     apu->periodSweepTimer = 0;
-    memset(apu->envelopeSweepTimer, 0, GBSoundChannelCount);
-    memset(apu->envelopeVolume, 0, GBSoundChannelCount);
-    memset(apu->activeChannels, false, GBSoundChannelCount);
-    memset(apu->channelValues, 0, GBSoundChannelCount);
-    memset(apu->channelClock, 0, GBSoundChannelCount);
+    apu->envelopeSweepTimer = (GBApuLanes){0};
+    apu->envelopeVolume = (GBApuLanes){0};
+    apu->activeChannels = (GBApuLanes){0};
+    apu->channelValues = (GBApuLanes){0};
     memset(apu->channelLen, 0, GBSoundChannelCount);
     memset(apu->data, 0, 0x20);
-    memset(apu->channelReaderCursors, 0, GBSoundChannelCount);
+    apu->channelReaderCursors = (GBApuLanes){0};
+    _GBApuUpdateGains(device);
 }
 
 void _GB_update_LFSR(GB_device* device) {
-    if (false == device->apu->activeChannels[GBSoundCH4]) {
+    if (false == device->apu.activeChannels[GBSoundCH4]) {
         return;
     }
-    GBApu* apu = device->apu;
+    GBApu* apu = &device->apu;
 
-    u_int16_t lfsr = apu->lfsrState;
+    uint16_t lfsr = apu->lfsrState;
 
-    u_int16_t bit = (lfsr & 0x1) == ((lfsr >> 1) & 0x1);
+    uint16_t bit = (lfsr & 0x1) == ((lfsr >> 1) & 0x1);
     lfsr = (lfsr & 0x7FFF) | (bit << 15);
     if ((apu->data[NR43] & 0x8) != 0) {
         lfsr = (lfsr & 0xFF7F) | (bit << 7);
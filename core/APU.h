@@ -1,7 +1,11 @@
 #pragma once
 
 #include "definitions.h"
+#include "BlipBuffer.h"
+#include "AudioRecorder.h"
+#include "VgmLogger.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #define NR10 0x00
@@ -36,6 +40,13 @@
 
 #define LFSR_START 0x2604
 
+// APU ticks between two band-limited frames (samples are flushed at frame end)
+#define GB_APU_FRAME_TICKS 2048
+// Stereo frames held by the output ring
+#define GB_APU_RING_FRAMES 0x2000
+// Default largest resampling ratio adjustment of the dynamic rate control
+#define GB_APU_RATE_CONTROL_DELTA 0.005
+
 typedef enum {
     GBSoundPaddingNone,
     GBSoundPaddingRight,
@@ -51,12 +62,39 @@ typedef enum {
     GBSoundChannelCount
 } GBSoundChannel;
 
+// One 32 bit lane per channel, mixed with 4-wide vector operations
+typedef int32_t GBApuLanes __attribute__((vector_size(4 * sizeof(int32_t))));
+// Same lanes holding absolute APU clocks, which wrap around
+typedef uint32_t GBApuClockLanes __attribute__((vector_size(4 * sizeof(uint32_t))));
+
+// One interleaved stereo frame
 struct GBSample_s {
     int16_t left;
     int16_t right;
 };
 
-typedef void (*GBApuSampleReady)(void* sender, GB_device *device, GBSample sample);
+// Optional per-channel mono outputs, before panning and master volume
+struct GBApuStems_s {
+    GBBlipBuffer blip[GBSoundChannelCount];
+    short level[GBSoundChannelCount];
+    GBRingBuffer* output[GBSoundChannelCount];
+};
+
+typedef struct GBApuStems_s GBApuStems;
+
+// Called once at least `blockFrames` frames are waiting in the output ring.
+// Runs on the thread emulating `device`, in the middle of a CPU step: it may
+// only use the consumer side of that device's output (GBApuReadSamples,
+// GBApuSkipSamples) and whatever `sender` holds. Nothing global is
+// involved, so devices running on separate threads each get their own calls.
+typedef void (*GBApuSampleBlockReady)(void* sender, GB_device *device, size_t availableFrames);
+
+typedef enum {
+    GBApuAudioModeFull,
+    // No waveform generation, mixing or output: only the state observable
+    // through registers (lengths, sweep, envelopes, NR52, wave RAM reads) runs
+    GBApuAudioModeHeadless
+} GBApuAudioMode;
 
 typedef enum {
     GBSweepAddition,
@@ -69,36 +107,84 @@ typedef enum {
 } GBEnvDirection;
 
 struct GBAPU_s {
-    u_int32_t clock;
-    u_int32_t sampleRate;
-    u_int16_t periodOnTrigger;
-    u_int16_t lfsrState;
-    u_int32_t waveReadclock;
+    uint32_t clock;
+    // APU ticks since the device was created, also counted while NR52 is off
+    uint64_t elapsedTicks;
+    uint16_t periodOnTrigger;
+    uint16_t lfsrState;
+    uint32_t waveReadclock;
     bool ch1SweepEnabled;
     bool ch1StepZero;
     bool ch1NegModeUsed;
     Byte divApu;
     Byte waveValue;
-    GBSample lastSample;
-    GBSample lastSampleOutput;
-    GBApuSampleReady sampleReadyCallback;
-    void* sampleReadyCallbackSender;
     bool divBitUp;
-    u_int8_t periodSweepTimer;
-    u_int16_t envelopeSweepTimer[GBSoundChannelCount];
-    Byte envelopeVolume[GBSoundChannelCount];
-    bool activeChannels[GBSoundChannelCount];
-    short channelValues[GBSoundChannelCount];
-    u_int32_t channelClock[GBSoundChannelCount];
+    uint8_t periodSweepTimer;
+    // Per-channel state, one lane per channel. The length counters and
+    // sweep pace stay bytes: only the frame sequencer touches them.
+    GBApuLanes envelopeSweepTimer;
+    GBApuLanes envelopeVolume;
+    // 1 while the channel is on, multiplies its value in the mix
+    GBApuLanes activeChannels;
+    GBApuLanes channelValues;
+    // NR51 panning times NR50 volume, updated when either is written
+    GBApuLanes gainLeft;
+    GBApuLanes gainRight;
+    // absolute APU clock of each channel's next output transition
+    GBApuClockLanes channelNextEvent;
+    // duty step of the square channels, wave RAM nibble of channel 3
+    GBApuLanes channelReaderCursors;
     Byte channelLen[GBSoundChannelCount];
     Byte channelSweepPace[GBSoundChannelCount];
-    u_int32_t channelClockDelay[GBSoundChannelCount];
-    Byte channelReaderCursors[GBSoundChannelCount];
     Byte data[0x30];
+
+    // Host side from here on: output configuration and buffers owned by
+    // this device, kept when state is copied in from another one. Must stay
+    // at the end, starting with `audioMode` (see GB_copyDeviceState).
+    GBApuAudioMode audioMode;
+    uint32_t sampleRate;
+    // band-limited output
+    uint32_t frameTicks;
+    GBSample outputLevel;
+    GBBlipSynth blipSynth;
+    GBBlipBuffer blipLeft;
+    GBBlipBuffer blipRight;
+    GBApuSampleBlockReady sampleBlockCallback;
+    void* sampleBlockCallbackSender;
+    uint32_t sampleBlockFrames;
+    // SPSC output ring: the emulation thread writes, any one thread reads
+    GBRingBuffer* output;
+    // dynamic rate control: the output ratio is nudged so the ring stays
+    // around `rateControlTarget` frames (0 disables it)
+    uint32_t rateControlTarget;
+    double rateControlMaxDelta;
+    double rateControlRatio;
+    // optional capture of everything written to the output ring
+    GBAudioRecorder* recorder;
+    // NULL unless stems are enabled
+    GBApuStems* stems;
+    // optional log of every register write
+    GBVgmLogger* vgmLog;
 };
 
 void GBWriteToAPURegister(GB_device* device, Word addr, Byte value);
 Byte GBReadAPURegister(GB_device* device, Word addr);
 void GBApuStep(GB_device* device, Byte cycles);
-void GBApuSetSampleReadyCallback(GB_device* device, GBApuSampleReady callback, void* sender);
+void GBApuSetSampleBlockCallback(GB_device* device, GBApuSampleBlockReady callback, uint32_t blockFrames, void* sender);
+size_t GBApuSamplesAvailable(GB_device* device);
+size_t GBApuReadSamples(GB_device* device, GBSample* buffer, size_t maxFrames);
+size_t GBApuSkipSamples(GB_device* device, size_t frames);
+void GBApuSetSampleRate(GB_device* device, uint32_t sampleRate);
+bool GBApuStartRecording(GB_device* device, const char* path, GBAudioRecorderFormat format);
+bool GBApuStopRecording(GB_device* device);
+bool GBApuStartVgmLog(GB_device* device, const char* path);
+bool GBApuStopVgmLog(GB_device* device);
+bool GBApuSetStemsEnabled(GB_device* device, bool enabled);
+size_t GBApuStemSamplesAvailable(GB_device* device, GBSoundChannel channel);
+size_t GBApuReadStemSamples(GB_device* device, GBSoundChannel channel, int16_t* buffer, size_t maxFrames);
+// Restarts host output from the current channel state, after it was restored.
+// `restartGenerators` when square/noise timing was not tracked (headless source).
+void GBApuResyncOutput(GB_device* device, bool restartGenerators);
+void GBApuSetAudioMode(GB_device* device, GBApuAudioMode mode);
+void GBApuSetRateControl(GB_device* device, uint32_t targetFrames, double maxDelta);
 void GBApuDiv(GB_device* device);
\ No newline at end of file
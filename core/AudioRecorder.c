@@ -0,0 +1,79 @@
+#include "AudioRecorder.h"
+#include "APU.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define GB_WAV_HEADER_SIZE 44
+
+// 16 bit stereo PCM header, sizes are 0 until the recorder is closed
+void _GBWavHeader(Byte* header, uint32_t sampleRate, uint32_t dataSize) {
+    memcpy(header, "RIFF", 4);
+    GBPutLE32(header + 4, dataSize + GB_WAV_HEADER_SIZE - 8);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    GBPutLE32(header + 16, 16);
+    GBPutLE16(header + 20, 1);                 // PCM
+    GBPutLE16(header + 22, 2);                 // channels
+    GBPutLE32(header + 24, sampleRate);
+    GBPutLE32(header + 28, sampleRate * sizeof(GBSample));
+    GBPutLE16(header + 32, sizeof(GBSample));  // block align
+    GBPutLE16(header + 34, 16);                // bits per sample
+    memcpy(header + 36, "data", 4);
+    GBPutLE32(header + 40, dataSize);
+}
+
+// Writer thread
+void _GBAudioRecorderWriteBlock(void* context, void* items, uint32_t count) {
+    GBAudioRecorder* recorder = context;
+    GBSample* block = items;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (uint32_t i = 0; i < count; i++) {
+        block[i].left = (int16_t)__builtin_bswap16((uint16_t)block[i].left);
+        block[i].right = (int16_t)__builtin_bswap16((uint16_t)block[i].right);
+    }
+#endif
+    GBFileWriterWrite(&recorder->writer, block, count * sizeof(GBSample));
+}
+
+GBAudioRecorder* GBAudioRecorderOpen(const char* path, GBAudioRecorderFormat format, uint32_t sampleRate) {
+    GBAudioRecorder* recorder = malloc(sizeof(GBAudioRecorder));
+    if (recorder == NULL) {
+        return NULL;
+    }
+    memset(recorder, 0, sizeof(GBAudioRecorder));
+    recorder->format = format;
+    recorder->sampleRate = sampleRate;
+
+    GBFileWriterFormat writerFormat = {
+        .name = "Recorder",
+        .itemSize = sizeof(GBSample),
+        .ringItems = GB_RECORDER_RING_FRAMES,
+        .blockItems = GB_RECORDER_BLOCK_FRAMES,
+        .writeBlock = _GBAudioRecorderWriteBlock,
+    };
+    Byte header[GB_WAV_HEADER_SIZE];
+    _GBWavHeader(header, sampleRate, 0);
+    bool hasHeader = format == GBAudioRecorderFormatWav;
+    if (!GBFileWriterOpen(&recorder->writer, path, writerFormat, recorder, hasHeader ? header : NULL, GB_WAV_HEADER_SIZE)) {
+        free(recorder);
+        return NULL;
+    }
+    return recorder;
+}
+
+void GBAudioRecorderPush(GBAudioRecorder* recorder, const GBSample* samples, uint32_t count) {
+    GBFileWriterPush(&recorder->writer, samples, count);
+}
+
+bool GBAudioRecorderClose(GBAudioRecorder* recorder) {
+    GBFileWriterStop(&recorder->writer);
+
+    bool hasHeader = recorder->format == GBAudioRecorderFormatWav;
+    Byte header[GB_WAV_HEADER_SIZE];
+    uint64_t dataSize = recorder->writer.bytesWritten - (hasHeader ? GB_WAV_HEADER_SIZE : 0);
+    _GBWavHeader(header, recorder->sampleRate, dataSize > UINT32_MAX - GB_WAV_HEADER_SIZE
+        ? UINT32_MAX - GB_WAV_HEADER_SIZE
+        : (uint32_t)dataSize);
+    bool success = GBFileWriterClose(&recorder->writer, hasHeader ? header : NULL, GB_WAV_HEADER_SIZE);
+    free(recorder);
+    return success;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "definitions.h"
+#include "FileWriter.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Streams APU output to disk through a GBFileWriter, so emulation never
+// does I/O. WAV sizes are patched in the header when the recorder is closed.
+
+// Stereo frames buffered between the emulation and the writer thread
+#define GB_RECORDER_RING_FRAMES 0x40000
+// The writer is woken once this many frames are waiting
+#define GB_RECORDER_BLOCK_FRAMES 0x4000
+
+typedef enum {
+    GBAudioRecorderFormatWav,
+    GBAudioRecorderFormatRaw   // headerless interleaved s16le
+} GBAudioRecorderFormat;
+
+struct GBAudioRecorder_s {
+    GBFileWriter writer;
+    GBAudioRecorderFormat format;
+    uint32_t sampleRate;
+};
+
+GBAudioRecorder* GBAudioRecorderOpen(const char* path, GBAudioRecorderFormat format, uint32_t sampleRate);
+// Emulation thread. Waits for the writer only when the ring is full, so no frame is lost.
+void GBAudioRecorderPush(GBAudioRecorder* recorder, const GBSample* samples, uint32_t count);
+// Flushes pending frames, finalizes the header and closes the file.
+// Returns false if any write failed.
+bool GBAudioRecorderClose(GBAudioRecorder* recorder);
@@ -0,0 +1,113 @@
+#include "BlipBuffer.h"
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define GB_BLIP_CUTOFF 0.9
+
+void GBBlipSynthInit(GBBlipSynth* synth) {
+    const int half = GB_BLIP_KERNEL_SIZE / 2;
+    const int unit = 1 << GB_BLIP_KERNEL_BITS;
+
+    for (int phase = 0; phase < GB_BLIP_PHASE_COUNT; phase++) {
+        double frac = (double)phase / GB_BLIP_PHASE_COUNT;
+        double taps[GB_BLIP_KERNEL_SIZE];
+        double total = 0;
+
+        for (int i = 0; i < GB_BLIP_KERNEL_SIZE; i++) {
+            // distance from the step, centered between taps half - 1 and half
+            double x = (i - (half - 1)) - frac;
+            double sinc = (x == 0) ? 1.0 : sin(M_PI * GB_BLIP_CUTOFF * x) / (M_PI * GB_BLIP_CUTOFF * x);
+            // Blackman window over the kernel span
+            double w = (x + half) / GB_BLIP_KERNEL_SIZE;
+            double window = 0.42 - 0.5 * cos(2 * M_PI * w) + 0.08 * cos(4 * M_PI * w);
+            if (w <= 0 || w >= 1) {
+                window = 0;
+            }
+            taps[i] = sinc * window;
+            total += taps[i];
+        }
+
+        // Normalize and push the rounding error in the largest tap so a step
+        // always integrates to exactly its amplitude (no DC drift).
+        int sum = 0;
+        int peak = 0;
+        for (int i = 0; i < GB_BLIP_KERNEL_SIZE; i++) {
+            int value = (int)lround(taps[i] * unit / total);
+            synth->kernel[phase][i] = value;
+            sum += value;
+            if (value > synth->kernel[phase][peak]) {
+                peak = i;
+            }
+        }
+        synth->kernel[phase][peak] += unit - sum;
+    }
+}
+
+void GBBlipSetRates(GBBlipBuffer* buffer, double clockRate, double sampleRate) {
+    buffer->factor = (uint64_t)(sampleRate / clockRate * ((uint64_t)1 << GB_BLIP_TIME_BITS) + 0.5);
+}
+
+void GBBlipClear(GBBlipBuffer* buffer) {
+    buffer->offset = 0;
+    buffer->integrator = 0;
+    memset(buffer->samples, 0, sizeof(buffer->samples));
+}
+
+void GBBlipAddDelta(const GBBlipSynth* synth, GBBlipBuffer* buffer, uint32_t time, int32_t delta) {
+    uint64_t position = buffer->offset + time * buffer->factor;
+    uint32_t index = (uint32_t)(position >> GB_BLIP_TIME_BITS);
+    if (index >= GB_BLIP_BUFFER_SIZE) {
+        return; // frame longer than the buffer, drop instead of overflowing
+    }
+
+    int phase = (position >> (GB_BLIP_TIME_BITS - GB_BLIP_PHASE_BITS)) & (GB_BLIP_PHASE_COUNT - 1);
+    const int16_t* kernel = synth->kernel[phase];
+    int32_t* out = buffer->samples + index;
+    for (int i = 0; i < GB_BLIP_KERNEL_SIZE; i++) {
+        out[i] += kernel[i] * delta;
+    }
+}
+
+void GBBlipEndFrame(GBBlipBuffer* buffer, uint32_t clockDuration) {
+    buffer->offset += clockDuration * buffer->factor;
+}
+
+int GBBlipSamplesAvailable(const GBBlipBuffer* buffer) {
+    int available = (int)(buffer->offset >> GB_BLIP_TIME_BITS);
+    return available > GB_BLIP_BUFFER_SIZE ? GB_BLIP_BUFFER_SIZE : available;
+}
+
+int GBBlipReadSamples(GBBlipBuffer* buffer, int16_t* out, int count, int stride) {
+    int available = GBBlipSamplesAvailable(buffer);
+    if (count > available) {
+        count = available;
+    }
+
+    int32_t sum = buffer->integrator;
+    for (int i = 0; i < count; i++) {
+        int32_t sample = sum >> GB_BLIP_KERNEL_BITS;
+        if (sample > INT16_MAX) {
+            sample = INT16_MAX;
+        } else if (sample < INT16_MIN) {
+            sample = INT16_MIN;
+        }
+        out[i * stride] = (int16_t)sample;
+
+        sum += buffer->samples[i];
+        // leaky integrator, acts as the DC blocking high pass filter
+        sum -= sample << (GB_BLIP_KERNEL_BITS - GB_BLIP_BASS_SHIFT);
+    }
+    buffer->integrator = sum;
+
+    // shift remaining samples (the kernel tail) to the start of the buffer
+    int remaining = available - count + GB_BLIP_KERNEL_SIZE;
+    memmove(buffer->samples, buffer->samples + count, remaining * sizeof(buffer->samples[0]));
+    memset(buffer->samples + remaining, 0, count * sizeof(buffer->samples[0]));
+    buffer->offset -= (uint64_t)count << GB_BLIP_TIME_BITS;
+
+    return count;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdint.h>
+
+// Band-limited step synthesis.
+// Amplitude changes are recorded as deltas at their exact clock time and
+// turned into output samples with a windowed-sinc step kernel, so the output
+// rate does not need to divide the emulated clock rate.
+
+#define GB_BLIP_PHASE_BITS   6
+#define GB_BLIP_PHASE_COUNT  (1 << GB_BLIP_PHASE_BITS)
+#define GB_BLIP_KERNEL_SIZE  16
+#define GB_BLIP_KERNEL_BITS  12
+#define GB_BLIP_BASS_SHIFT   9
+#define GB_BLIP_TIME_BITS    32
+#define GB_BLIP_BUFFER_SIZE  1024
+
+struct GBBlipSynth_s {
+    // Impulse response of a unit step for each sub-sample phase.
+    // Every row sums to exactly 1 << GB_BLIP_KERNEL_BITS.
+    int16_t kernel[GB_BLIP_PHASE_COUNT][GB_BLIP_KERNEL_SIZE];
+};
+
+typedef struct GBBlipSynth_s GBBlipSynth;
+
+struct GBBlipBuffer_s {
+    // output samples per clock, 32.32 fixed point
+    uint64_t factor;
+    // position of clock 0 of the current frame, 32.32 fixed point
+    uint64_t offset;
+    int32_t integrator;
+    int32_t samples[GB_BLIP_BUFFER_SIZE + GB_BLIP_KERNEL_SIZE];
+};
+
+typedef struct GBBlipBuffer_s GBBlipBuffer;
+
+void GBBlipSynthInit(GBBlipSynth* synth);
+void GBBlipSetRates(GBBlipBuffer* buffer, double clockRate, double sampleRate);
+void GBBlipClear(GBBlipBuffer* buffer);
+void GBBlipAddDelta(const GBBlipSynth* synth, GBBlipBuffer* buffer, uint32_t time, int32_t delta);
+void GBBlipEndFrame(GBBlipBuffer* buffer, uint32_t clockDuration);
+int  GBBlipSamplesAvailable(const GBBlipBuffer* buffer);
+int  GBBlipReadSamples(GBBlipBuffer* buffer, int16_t* out, int count, int stride);
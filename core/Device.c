@@ -4,65 +4,76 @@
 #include "PPU.h"
 #include "MMU.h"
 #include "APU.h"
+#include "RingBuffer.h"
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
-GB_device* GB_newDevice() {
-    GB_device* device = malloc(sizeof(GB_device));
-    if (device == NULL) {
+size_t GB_deviceStorageSize(void) {
+    return (sizeof(GB_device) + GB_DEVICE_ALIGNMENT - 1) & ~(size_t)(GB_DEVICE_ALIGNMENT - 1);
+}
+
+GB_device* GB_initDevice(void* storage) {
+    if (storage == NULL || ((uintptr_t)storage & (GB_DEVICE_ALIGNMENT - 1)) != 0) {
         return NULL;
     }
+    GB_device* device = storage;
     memset(device, 0, sizeof(GB_device));
+    device->externalStorage = true;
 
-    GB_cpu* cpu = malloc(sizeof(GB_cpu));
-    if (cpu == NULL) {
-        free(device);
-        return NULL;
-    }
-    memset(cpu, 0, sizeof(GB_cpu));
+    GB_reset(device);
 
-    GB_mmu* mmu = malloc(sizeof(GB_mmu));
-    if (mmu == NULL) {
-        free(device);
-        free(cpu);
+    return device;
+}
+
+GB_device* GB_newDevice() {
+    void* storage = aligned_alloc(GB_DEVICE_ALIGNMENT, GB_deviceStorageSize());
+    GB_device* device = GB_initDevice(storage);
+    if (device == NULL) {
         return NULL;
     }
-    memset(mmu, 0, sizeof(GB_mmu));
+    device->externalStorage = false;
+    return device;
+}
 
-    GB_ppu* ppu = malloc(sizeof(GB_ppu));
-    if (ppu == NULL) {
+void GB_freeDevice(GB_device* device) {
+    GBApuStopRecording(device);
+    GBApuStopVgmLog(device);
+    GBApuSetStemsEnabled(device, false);
+    GBRingBufferFree(device->apu.output);
+    device->apu.output = NULL;
+    GB_deviceReleaseRom(device);
+    if (device->externalStorage == false) {
         free(device);
-        free(cpu);
-        free(mmu);
-        return NULL;
     }
-    memset(ppu, 0, sizeof(GB_ppu));
+}
 
-    GBApu* apu = malloc(sizeof(GBApu));
-    if (apu == NULL) {
-        free(device);
-        free(cpu);
-        free(mmu);
-        free(ppu);
+GB_device* GB_cloneDevice(const GB_device* src) {
+    GB_device* device = aligned_alloc(GB_DEVICE_ALIGNMENT, GB_deviceStorageSize());
+    if (device == NULL) {
         return NULL;
     }
-    memset(apu, 0, sizeof(GBApu));
-
-    device->cpu = cpu;
-    device->mmu = mmu;
-    device->ppu = ppu;
-    device->apu = apu;
-
-    GB_reset(device);
-
+    memset(device, 0, sizeof(GB_device));
+    device->apu.audioMode = src->apu.audioMode;
+    GB_copyDeviceState(device, src);
     return device;
 }
 
-void GB_freeDevice(GB_device* device) {
-    free(device->cpu);
-    free(device->mmu);
-    free(device->ppu);
-    free(device);
+void GB_copyDeviceState(GB_device* dst, const GB_device* src) {
+    if (dst == src) {
+        return;
+    }
+    if (dst->mmu.rom != src->mmu.rom) {
+        GB_deviceReleaseRom(dst);
+    }
+    bool romShared = dst->mmu.rom == NULL || dst->mmu.romShared;
+
+    memcpy(dst, src, offsetof(GB_device, apu.audioMode));
+
+    dst->mmu.romShared = romShared;
+    // a headless source did not step the square and noise generators
+    bool generatorsStale = src->apu.audioMode == GBApuAudioModeHeadless;
+    GBApuResyncOutput(dst, generatorsStale);
 }
 
 void GB_reset(GB_device* device) {
@@ -72,21 +83,21 @@ void GB_reset(GB_device* device) {
 }
 
 void GB_updateDivCounter(GB_device* device, Byte cycles) {
-    GB_cpu* cpu = device->cpu;
-    GB_mmu* mmu = device->mmu;
+    GB_cpu* cpu = &device->cpu;
+    GB_mmu* mmu = &device->mmu;
 
     // Update TIMA if enabled
-    u_int16_t timaMask[] = {0x100, 0x04, 0x10, 0x40};
-    u_int16_t bitTracked = timaMask[mmu->timaClockCycles];
-    u_int16_t ticks = cycles / 4;
+    uint16_t timaMask[] = {0x100, 0x04, 0x10, 0x40};
+    uint16_t bitTracked = timaMask[mmu->timaClockCycles];
+    uint16_t ticks = cycles / 4;
 
     Byte prevDiv = mmu->div;
     
     for (int i = 0; i < ticks; i++) {
 
         // update DIV register
-        u_int32_t newDiv = cpu->divCounter + 1;
-        u_int32_t triggers = cpu->divCounter & ~newDiv;
+        uint32_t newDiv = cpu->divCounter + 1;
+        uint32_t triggers = cpu->divCounter & ~newDiv;
 
         cpu->divCounter = newDiv;
         mmu->div = (cpu->divCounter >> 8);
@@ -102,7 +113,7 @@ void GB_updateDivCounter(GB_device* device, Byte cycles) {
         if (triggers & 0x400) {
              GBApuDiv(device);
         }
-        prevDiv = device->mmu->div;
+        prevDiv = device->mmu.div;
     }
 }
 
@@ -110,10 +121,32 @@ void GB_emulationStep(GB_device* device) {
     Byte cycles = GB_deviceCpuStep(device);
 }
 
+void GB_runFrame(GB_device* device) {
+    uint32_t cycles = 0;
+    while (device->ppu.frameReady == false) {
+        cycles += GB_deviceCpuStep(device);
+        if (cycles >= GB_DEVICE_FRAME_CYCLES && device->ppuDisabled) {
+            break;
+        }
+    }
+    device->ppu.frameReady = false;
+}
+
 void GB_emulationAdvance(GB_device* device, Byte cycles) {
+    GB_PROFILE_ENTER(device, GBProfileTimer);
     GB_update_tima_status(device);
     GB_updateDivCounter(device, cycles);
-    GBProcessMemEvents(device, cycles);
-    GB_devicePPUstep(device, cycles);
+    device->mmu.cycleCount += cycles;
+    if (device->mmu.cycleCount >= device->mmu.serialEventCycle) {
+        GBSerialTransferComplete(device);
+    }
+    GB_PROFILE_LEAVE(device);
+    if (device->ppuDisabled == false) {
+        GB_PROFILE_ENTER(device, GBProfilePPU);
+        GB_devicePPUstep(device, cycles);
+        GB_PROFILE_LEAVE(device);
+    }
+    GB_PROFILE_ENTER(device, GBProfileAPU);
     GBApuStep(device, cycles);
+    GB_PROFILE_LEAVE(device);
 }
\ No newline at end of file
@@ -1,16 +1,61 @@
 #pragma once
 
 #include "definitions.h"
+#include "CPU.h"
+#include "MMU.h"
+#include "PPU.h"
+#include "APU.h"
+#include "Profile.h"
+#include <stdbool.h>
+#include <stddef.h>
 
+// Devices are aligned on this so the hot state starts on a cache line
+#define GB_DEVICE_ALIGNMENT 64
+// CPU cycles of one video frame, 154 lines of 456 dots
+#define GB_DEVICE_FRAME_CYCLES 70224
+
+// The whole machine is one block: subsystems are embedded by value, hot
+// state first (CPU and MMU registers are touched on every memory access),
+// bulk memory and the APU output state after.
 struct GB_device_s {
-    GB_cpu* cpu;
-    GB_mmu* mmu;
-    GB_ppu* ppu;
-    GBApu*  apu;
+    GB_cpu cpu;
+    GB_mmu mmu;
+    // CPU, timers and APU only (GBS playback), the PPU is never stepped
+    bool ppuDisabled;
+    // PPU timing and interrupts run but no pixel is drawn (hidden frames)
+    bool ppuSkipPixels;
+    GB_ppu ppu;
+    // emulated APU state, then its host output (see GB_copyDeviceState)
+    GBApu  apu;
+    // storage was supplied by the caller (GB_initDevice), not owned
+    bool externalStorage;
+    // host sink for serial output, like the APU output it stays with the
+    // device and is never copied
+    GBSerialByteCallback serialCallback;
+    void* serialCallbackSender;
+#ifdef GB_PROFILE
+    // bench builds only, see Profile.h
+    GBProfile profile;
+#endif
 };
 
 GB_device* GB_newDevice();
 void GB_freeDevice(GB_device* device);
+// Caller-supplied storage: `storage` must hold GB_deviceStorageSize() bytes
+// aligned on GB_DEVICE_ALIGNMENT. GB_freeDevice releases the resources the
+// device owns (ROM, audio buffers) but leaves the storage to the caller.
+size_t GB_deviceStorageSize(void);
+GB_device* GB_initDevice(void* storage);
+// Independent copy of `src`. Everything up to the APU host output is copied
+// in one block, including derived caches (PPU tiles). The ROM is borrowed:
+// `src` must outlive the copy. Audio output, recorders, logs and the serial
+// callback are not shared, the copy keeps its own (a clone starts in `src`'s
+// audio mode with no output).
+GB_device* GB_cloneDevice(const GB_device* src);
+void GB_copyDeviceState(GB_device* dst, const GB_device* src);
 void GB_reset(GB_device* device);
 void GB_emulationStep(GB_device* device);
-void GB_emulationAdvance(GB_device* device, Byte cycles);
\ No newline at end of file
+// Runs until the PPU finishes a frame (and clears `frameReady`), or for one
+// frame worth of cycles when the PPU is disabled
+void GB_runFrame(GB_device* device);
+void GB_emulationAdvance(GB_device* device, Byte cycles);
@@ -0,0 +1,84 @@
+#include "DevicePool.h"
+#include "Device.h"
+#include <stdlib.h>
+#include <string.h>
+
+GBDevicePool* GBDevicePoolCreate(uint32_t capacity) {
+    if (capacity == 0) {
+        return NULL;
+    }
+    GBDevicePool* pool = malloc(sizeof(GBDevicePool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->slotSize = GB_deviceStorageSize();
+    pool->capacity = capacity;
+    pool->storage = aligned_alloc(GB_DEVICE_ALIGNMENT, pool->slotSize * capacity);
+    pool->freeSlots = malloc(capacity * sizeof(uint32_t));
+    pool->acquired = calloc(capacity, sizeof(bool));
+    if (pool->storage == NULL || pool->freeSlots == NULL || pool->acquired == NULL) {
+        free(pool->storage);
+        free(pool->freeSlots);
+        free(pool->acquired);
+        free(pool);
+        return NULL;
+    }
+
+    // initialized once here, acquiring only copies state over a slot
+    for (uint32_t i = 0; i < capacity; i++) {
+        GB_initDevice(pool->storage + (size_t)i * pool->slotSize);
+        // lowest slots handed out first
+        pool->freeSlots[i] = capacity - 1 - i;
+    }
+    pool->freeCount = capacity;
+    return pool;
+}
+
+void GBDevicePoolFree(GBDevicePool* pool) {
+    if (pool == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < pool->capacity; i++) {
+        GB_freeDevice((GB_device*)(pool->storage + (size_t)i * pool->slotSize));
+    }
+    free(pool->storage);
+    free(pool->freeSlots);
+    free(pool->acquired);
+    free(pool);
+}
+
+GB_device* GBDevicePoolAcquire(GBDevicePool* pool, const GB_device* src) {
+    if (pool->freeCount == 0) {
+        return NULL;
+    }
+    uint32_t slot = pool->freeSlots[--pool->freeCount];
+    pool->acquired[slot] = true;
+    GB_device* device = (GB_device*)(pool->storage + (size_t)slot * pool->slotSize);
+    device->apu.audioMode = src->apu.audioMode;
+    GB_copyDeviceState(device, src);
+    return device;
+}
+
+bool GBDevicePoolRelease(GBDevicePool* pool, GB_device* device) {
+    if ((Byte*)device < pool->storage) {
+        return false;
+    }
+    size_t offset = (Byte*)device - pool->storage;
+    if (offset >= pool->slotSize * pool->capacity || offset % pool->slotSize != 0) {
+        return false; // not a device of this pool
+    }
+    uint32_t slot = (uint32_t)(offset / pool->slotSize);
+    if (pool->acquired[slot] == false) {
+        return false; // already released
+    }
+    // drops whatever the device acquired on its own (audio buffers, a ROM
+    // loaded into it), the slot itself stays initialized
+    GB_freeDevice(device);
+    pool->acquired[slot] = false;
+    pool->freeSlots[pool->freeCount++] = slot;
+    return true;
+}
+
+uint32_t GBDevicePoolAvailable(GBDevicePool* pool) {
+    return pool->freeCount;
+}
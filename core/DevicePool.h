@@ -0,0 +1,32 @@
+#pragma once
+
+#include "definitions.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Fixed set of device slots for branching many short-lived copies off one
+// state (search, run-ahead). All slots live in one aligned block allocated
+// up front, so acquiring and releasing a device never allocates.
+
+struct GBDevicePool_s {
+    Byte* storage;
+    size_t slotSize;
+    uint32_t capacity;
+    // indexes of the free slots, used as a stack
+    uint32_t* freeSlots;
+    uint32_t freeCount;
+    // per slot, so a release can tell a handed out device from a free one
+    bool* acquired;
+};
+
+GBDevicePool* GBDevicePoolCreate(uint32_t capacity);
+// Also drops the devices still acquired
+void GBDevicePoolFree(GBDevicePool* pool);
+// Copy of `src` in a free slot (see GB_copyDeviceState), NULL when the pool
+// is exhausted
+GB_device* GBDevicePoolAcquire(GBDevicePool* pool, const GB_device* src);
+// Returns false, and does nothing, if `device` is not a device currently
+// acquired from this pool (a second release, a pointer inside a slot)
+bool GBDevicePoolRelease(GBDevicePool* pool, GB_device* device);
+uint32_t GBDevicePoolAvailable(GBDevicePool* pool);
@@ -0,0 +1,165 @@
+#include "FileWriter.h"
+#include "Helper.h"
+#include "RingBuffer.h"
+#include <stdlib.h>
+#include <string.h>
+
+void GBPutLE16(Byte* out, uint16_t value) {
+    out[0] = value & 0xFF;
+    out[1] = value >> 8;
+}
+
+void GBPutLE32(Byte* out, uint32_t value) {
+    out[0] = value & 0xFF;
+    out[1] = (value >> 8) & 0xFF;
+    out[2] = (value >> 16) & 0xFF;
+    out[3] = value >> 24;
+}
+
+bool GBFileWriterWrite(GBFileWriter* writer, const void* data, size_t size) {
+    if (writer->failed) {
+        return false;
+    }
+    size_t written = fwrite(data, 1, size, writer->file);
+    writer->bytesWritten += written;
+    if (written != size) {
+        GBprintf("%s: write failed\n", writer->format.name);
+        writer->failed = true;
+        return false;
+    }
+    return true;
+}
+
+void _GBFileWriterSignalSpace(GBFileWriter* writer) {
+    pthread_mutex_lock(&writer->lock);
+    pthread_cond_signal(&writer->spaceReady);
+    pthread_mutex_unlock(&writer->lock);
+}
+
+void* _GBFileWriterThread(void* context) {
+    GBFileWriter* writer = context;
+    uint32_t blockItems = writer->format.blockItems;
+    void* block = malloc((size_t)blockItems * writer->format.itemSize);
+    if (block == NULL) {
+        writer->failed = true;
+    }
+
+    while (true) {
+        pthread_mutex_lock(&writer->lock);
+        while (writer->stopping == false && GBRingBufferReadAvailable(writer->ring) < blockItems) {
+            pthread_cond_wait(&writer->dataReady, &writer->lock);
+        }
+        bool stopping = writer->stopping;
+        pthread_mutex_unlock(&writer->lock);
+
+        uint32_t count;
+        do {
+            if (block != NULL) {
+                count = GBRingBufferRead(writer->ring, block, blockItems);
+                if (count > 0) {
+                    writer->format.writeBlock(writer->context, block, count);
+                }
+            } else {
+                // nothing can be written, discard so the producer is not stuck
+                count = GBRingBufferSkip(writer->ring, GBRingBufferReadAvailable(writer->ring));
+            }
+            _GBFileWriterSignalSpace(writer);
+        } while (count == blockItems);
+
+        if (stopping && GBRingBufferReadAvailable(writer->ring) == 0) {
+            break;
+        }
+    }
+
+    free(block);
+    return NULL;
+}
+
+bool GBFileWriterOpen(GBFileWriter* writer, const char* path, GBFileWriterFormat format, void* context,
+                      const void* header, size_t headerSize) {
+    memset(writer, 0, sizeof(GBFileWriter));
+    writer->format = format;
+    writer->context = context;
+
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL) {
+        GBprintf("%s: unable to open %s\n", format.name, path);
+        return false;
+    }
+    if (header != NULL) {
+        GBFileWriterWrite(writer, header, headerSize);
+    }
+
+    writer->ring = GBRingBufferCreate(format.ringItems, format.itemSize);
+    if (writer->ring == NULL) {
+        fclose(writer->file);
+        return false;
+    }
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->dataReady, NULL);
+    pthread_cond_init(&writer->spaceReady, NULL);
+    if (pthread_create(&writer->thread, NULL, _GBFileWriterThread, writer) != 0) {
+        pthread_cond_destroy(&writer->spaceReady);
+        pthread_cond_destroy(&writer->dataReady);
+        pthread_mutex_destroy(&writer->lock);
+        GBRingBufferFree(writer->ring);
+        fclose(writer->file);
+        return false;
+    }
+    writer->running = true;
+    return true;
+}
+
+void GBFileWriterPush(GBFileWriter* writer, const void* items, uint32_t count) {
+    const Byte* bytes = items;
+    while (count > 0) {
+        uint32_t written = GBRingBufferWrite(writer->ring, bytes, count);
+        bytes += (size_t)written * writer->format.itemSize;
+        count -= written;
+
+        if (count == 0 && GBRingBufferReadAvailable(writer->ring) < writer->format.blockItems) {
+            return; // common case, no block ready yet
+        }
+
+        pthread_mutex_lock(&writer->lock);
+        pthread_cond_signal(&writer->dataReady);
+        if (count > 0 && GBRingBufferWriteAvailable(writer->ring) == 0) {
+            // running faster than the disk, wait for the writer instead of dropping
+            pthread_cond_wait(&writer->spaceReady, &writer->lock);
+        }
+        pthread_mutex_unlock(&writer->lock);
+    }
+}
+
+void GBFileWriterStop(GBFileWriter* writer) {
+    if (writer->running == false) {
+        return;
+    }
+    pthread_mutex_lock(&writer->lock);
+    writer->stopping = true;
+    pthread_cond_signal(&writer->dataReady);
+    pthread_mutex_unlock(&writer->lock);
+    pthread_join(writer->thread, NULL);
+    writer->running = false;
+}
+
+bool GBFileWriterClose(GBFileWriter* writer, const void* header, size_t headerSize) {
+    GBFileWriterStop(writer);
+
+    bool success = !writer->failed;
+    if (header != NULL && success) {
+        if (fseek(writer->file, 0, SEEK_SET) != 0 ||
+            fwrite(header, 1, headerSize, writer->file) != headerSize) {
+            success = false;
+        }
+    }
+    if (fclose(writer->file) != 0) {
+        success = false;
+    }
+
+    pthread_cond_destroy(&writer->spaceReady);
+    pthread_cond_destroy(&writer->dataReady);
+    pthread_mutex_destroy(&writer->lock);
+    GBRingBufferFree(writer->ring);
+    return success;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "definitions.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Background file writer shared by the audio recorder and the VGM logger.
+// The emulation thread appends fixed-size items to a large ring; a writer
+// thread drains it in blocks, hands each block to the format to encode and
+// owns the file, so emulation never does I/O. The producer only waits when
+// the ring is full, so nothing is ever dropped.
+// Once GBFileWriterStop returned the owner may append a trailer and
+// GBFileWriterClose rewrites the header with the final sizes.
+
+struct GBFileWriterFormat_s {
+    // prefix of the log messages, e.g. "VGM"
+    const char* name;
+    uint32_t itemSize;
+    uint32_t ringItems;
+    // the writer thread is woken once this many items are waiting
+    uint32_t blockItems;
+    // writer thread, encodes `count` items with GBFileWriterWrite
+    void (*writeBlock)(void* context, void* items, uint32_t count);
+};
+
+typedef struct GBFileWriterFormat_s GBFileWriterFormat;
+
+struct GBFileWriter_s {
+    FILE* file;
+    GBFileWriterFormat format;
+    void* context;
+    GBRingBuffer* ring;
+    pthread_t thread;
+    bool running;
+    pthread_mutex_t lock;
+    // signaled when a block is ready or the writer is stopping
+    pthread_cond_t dataReady;
+    // signaled when the writer thread made room in the ring
+    pthread_cond_t spaceReady;
+    bool stopping;
+    bool failed;
+    // header included
+    uint64_t bytesWritten;
+};
+
+typedef struct GBFileWriter_s GBFileWriter;
+
+// Creates `path`, writes the placeholder `header` (may be NULL) and starts
+// the writer thread. Returns false, with nothing left open, on failure.
+bool GBFileWriterOpen(GBFileWriter* writer, const char* path, GBFileWriterFormat format, void* context,
+                      const void* header, size_t headerSize);
+// Emulation thread
+void GBFileWriterPush(GBFileWriter* writer, const void* items, uint32_t count);
+// Writer thread, or the owner once stopped. After a failure every write is
+// skipped, the ring keeps draining so the producer never stalls.
+bool GBFileWriterWrite(GBFileWriter* writer, const void* data, size_t size);
+// Writes out every pending item and joins the writer thread
+void GBFileWriterStop(GBFileWriter* writer);
+// Stops if needed, rewrites `header` (may be NULL) over the placeholder and
+// closes the file. Returns false if any write failed.
+bool GBFileWriterClose(GBFileWriter* writer, const void* header, size_t headerSize);
+
+void GBPutLE16(Byte* out, uint16_t value);
+void GBPutLE32(Byte* out, uint32_t value);
@@ -0,0 +1,139 @@
+#include "FrameHash.h"
+#include "Device.h"
+#include "PPU.h"
+#include "MMU.h"
+#include <string.h>
+
+#define GB_FRAME_WIDTH 160
+#define GB_FRAME_HEIGHT 144
+
+#define XXH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define XXH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3 0x165667B19E3779F9ULL
+#define XXH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+static inline uint64_t _GBHashRotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// little-endian byte loads: same hash on any host, any alignment
+static inline uint64_t _GBHashRead64(const Byte* p) {
+    return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24) |
+           ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+}
+
+static inline uint32_t _GBHashRead32(const Byte* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint64_t _GBHashRound(uint64_t acc, uint64_t input) {
+    acc += input * XXH_PRIME64_2;
+    acc = _GBHashRotl(acc, 31);
+    return acc * XXH_PRIME64_1;
+}
+
+static inline uint64_t _GBHashMergeRound(uint64_t acc, uint64_t value) {
+    acc ^= _GBHashRound(0, value);
+    return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+uint64_t GB_hash64(const void* data, size_t length, uint64_t seed) {
+    const Byte* p = data;
+    const Byte* end = p + length;
+    uint64_t hash;
+
+    if (length >= 32) {
+        // four independent lanes keep the multipliers busy
+        uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+        uint64_t v2 = seed + XXH_PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - XXH_PRIME64_1;
+        const Byte* limit = end - 32;
+        do {
+            v1 = _GBHashRound(v1, _GBHashRead64(p));
+            v2 = _GBHashRound(v2, _GBHashRead64(p + 8));
+            v3 = _GBHashRound(v3, _GBHashRead64(p + 16));
+            v4 = _GBHashRound(v4, _GBHashRead64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        hash = _GBHashRotl(v1, 1) + _GBHashRotl(v2, 7) + _GBHashRotl(v3, 12) + _GBHashRotl(v4, 18);
+        hash = _GBHashMergeRound(hash, v1);
+        hash = _GBHashMergeRound(hash, v2);
+        hash = _GBHashMergeRound(hash, v3);
+        hash = _GBHashMergeRound(hash, v4);
+    } else {
+        hash = seed + XXH_PRIME64_5;
+    }
+    hash += length;
+
+    while (p + 8 <= end) {
+        hash ^= _GBHashRound(0, _GBHashRead64(p));
+        hash = _GBHashRotl(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+        p += 8;
+    }
+    if (p + 4 <= end) {
+        hash ^= (uint64_t)_GBHashRead32(p) * XXH_PRIME64_1;
+        hash = _GBHashRotl(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        p += 4;
+    }
+    while (p < end) {
+        hash ^= (*p) * XXH_PRIME64_5;
+        hash = _GBHashRotl(hash, 11) * XXH_PRIME64_1;
+        p++;
+    }
+
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// One byte per pixel: the palette shade, +4 for object pixels (objects
+// draw their shade 0 transparent, unlike the background). Mirrors the
+// composition of GB_ppu_gen_frame_bitmap. Picking the visible layer is
+// kept branch free so the compiler can vectorize it, a byte table then
+// applies the palettes.
+static void _GBComposeFrame(GB_ppu* ppu, Byte* shades) {
+    Byte palette[8];
+    for (int i = 0; i < 4; i++) {
+        palette[i] = ppu->bgpIdColors[i] & 0x3;
+        palette[4 + i] = 4 | (ppu->objp0IdColor[i] & 0x3);
+    }
+    // plain integer views, enum and bool loads get in the vectorizer's way
+    const uint32_t* bg = (const uint32_t*)ppu->frameBuffer[GBBackgroundFrameBuffer];
+    const uint32_t* obj = (const uint32_t*)ppu->frameBuffer[GBObjectFrameBuffer];
+    const uint8_t* priorities = (const uint8_t*)ppu->objPriorities;
+    for (int i = 0; i < GB_FRAME_WIDTH * GB_FRAME_HEIGHT; i++) {
+        uint8_t bgId = (uint8_t)bg[i] & 0x3;
+        uint8_t objId = (uint8_t)obj[i] & 0x3;
+        uint8_t objVisible = (objId != 0) & (priorities[i] | (bgId == 0));
+        shades[i] = objVisible ? 4 | objId : bgId;
+    }
+    for (int i = 0; i < GB_FRAME_WIDTH * GB_FRAME_HEIGHT; i++) {
+        shades[i] = palette[shades[i]];
+    }
+}
+
+uint64_t GB_device_hash(GB_device* device, int regions) {
+    uint64_t hash = 0;
+    if (regions & GBHashRegionFrame) {
+        Byte shades[GB_FRAME_WIDTH * GB_FRAME_HEIGHT];
+        _GBComposeFrame(&device->ppu, shades);
+        hash = GB_hash64(shades, sizeof(shades), hash);
+    }
+    if (regions & GBHashRegionWRAM) {
+        hash = GB_hash64(device->mmu.wRam, sizeof(device->mmu.wRam), hash);
+    }
+    if (regions & GBHashRegionVRAM) {
+        hash = GB_hash64(device->ppu.vRam, sizeof(device->ppu.vRam), hash);
+    }
+    return hash;
+}
+
+uint64_t GB_frame_hash(GB_device* device) {
+    return GB_device_hash(device, GBHashRegionFrame);
+}
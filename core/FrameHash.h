@@ -0,0 +1,26 @@
+#pragma once
+
+#include "definitions.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// 64-bit hashes of what the device shows, for golden-frame regression
+// tests and quick "did anything change" checks.
+// The frame is hashed as composed for display (background, window and
+// objects merged, palettes applied, one byte per pixel), so two devices
+// that show the same picture hash the same whatever path drew it. The
+// hash is XXH64, plain 64-bit multiply/rotate arithmetic that runs at
+// memory speed without any instruction set extension.
+
+typedef enum {
+    GBHashRegionFrame = 1 << 0,
+    GBHashRegionWRAM  = 1 << 1,
+    GBHashRegionVRAM  = 1 << 2,
+} GBHashRegion;
+
+uint64_t GB_hash64(const void* data, size_t length, uint64_t seed);
+// Hash of the composed frame, same as GB_device_hash(device, GBHashRegionFrame)
+uint64_t GB_frame_hash(GB_device* device);
+// Hash of the frame and/or memory regions, `regions` is a GBHashRegion mask.
+// Each region is hashed on its own and chained in the order above.
+uint64_t GB_device_hash(GB_device* device, int regions);
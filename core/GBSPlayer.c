@@ -0,0 +1,210 @@
+#include "GBSPlayer.h"
+#include "Device.h"
+#include "CPU.h"
+#include "MMU.h"
+#include "APU.h"
+#include "Helper.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// idle time is emulated in chunks, GB_emulationAdvance takes a Byte
+#define GBS_IDLE_CYCLES 128
+
+Word _GBSReadWord(const Byte* data) {
+    return data[0] | (data[1] << 8);
+}
+
+bool _GBSParseHeader(const Byte* data, GBSHeader* header) {
+    if (memcmp(data, "GBS", 3) != 0) {
+        return false;
+    }
+    header->version = data[0x03];
+    header->songCount = data[0x04];
+    header->firstSong = data[0x05];
+    header->loadAddress = _GBSReadWord(data + 0x06);
+    header->initAddress = _GBSReadWord(data + 0x08);
+    header->playAddress = _GBSReadWord(data + 0x0A);
+    header->stackPointer = _GBSReadWord(data + 0x0C);
+    header->timerModulo = data[0x0E];
+    header->timerControl = data[0x0F];
+    memcpy(header->title, data + 0x10, 32);
+    memcpy(header->author, data + 0x30, 32);
+    memcpy(header->copyright, data + 0x50, 32);
+    header->title[32] = 0;
+    header->author[32] = 0;
+    header->copyright[32] = 0;
+
+    // the low bytes are used by the player stub below
+    return header->loadAddress >= 0x0080 && header->loadAddress < 0x8000;
+}
+
+// RST vectors jump to their relocated copies at loadAddress, interrupts are
+// ignored and routines return into an endless JR at GBS_RETURN_ADDRESS.
+void _GBSWriteStub(Byte* rom, Word loadAddress) {
+    for (int rst = 0; rst < 0x40; rst += 8) {
+        Word target = loadAddress + rst;
+        rom[rst] = 0xC3; // JP a16
+        rom[rst + 1] = target & 0xFF;
+        rom[rst + 2] = target >> 8;
+    }
+    for (int vector = 0x40; vector <= 0x60; vector += 8) {
+        rom[vector] = 0xD9; // RETI
+    }
+    rom[GBS_RETURN_ADDRESS] = 0x18; // JR -2
+    rom[GBS_RETURN_ADDRESS + 1] = 0xFE;
+}
+
+GBSPlayer* GBSPlayerOpen(GB_device* device, const char* filePath) {
+    FILE* file = fopen(filePath, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    if (fseek(file, 0, SEEK_END) != 0) {
+        fclose(file);
+        return NULL;
+    }
+    long fileSize = ftell(file);
+    if (fileSize <= GBS_HEADER_SIZE || fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return NULL;
+    }
+    Byte* data = malloc(fileSize);
+    if (data == NULL) {
+        fclose(file);
+        return NULL;
+    }
+    size_t readSize = fread(data, 1, fileSize, file);
+    fclose(file);
+
+    GBSPlayer* player = malloc(sizeof(GBSPlayer));
+    if (player == NULL || readSize != (size_t)fileSize || _GBSParseHeader(data, &player->header) == false) {
+        GBprintf("GBS: %s is not a valid GBS file\n", filePath);
+        free(player);
+        free(data);
+        return NULL;
+    }
+
+    // ROM image: stub, then the rip at its load address, padded to whole banks
+    uint32_t codeSize = (uint32_t)(fileSize - GBS_HEADER_SIZE);
+    uint32_t romSize = (player->header.loadAddress + codeSize + 0x3FFF) & ~0x3FFF;
+    if (romSize < 0x8000) {
+        romSize = 0x8000;
+    }
+    Byte* rom = malloc(romSize);
+    if (rom == NULL) {
+        free(player);
+        free(data);
+        return NULL;
+    }
+    memset(rom, 0, romSize);
+    memcpy(rom + player->header.loadAddress, data + GBS_HEADER_SIZE, codeSize);
+    _GBSWriteStub(rom, player->header.loadAddress);
+    free(data);
+
+    GB_deviceReleaseRom(device);
+    device->mmu.rom = rom;
+    device->mmu.romSize = romSize;
+    device->mmu.romHash = GB_romHash(rom, romSize);
+    device->mmu.romBanking = true;
+    device->mmu.romBankCount = romSize / 0x4000;
+    device->ppuDisabled = true;
+
+    player->device = device;
+    player->currentSong = 0;
+    player->cyclesToPlay = 0;
+    return player;
+}
+
+void GBSPlayerFree(GBSPlayer* player) {
+    free(player);
+}
+
+uint32_t GBSPlayerPlayPeriod(GBSPlayer* player) {
+    GB_mmu* mmu = &player->device->mmu;
+    if ((mmu->tac & 0x04) == 0) {
+        return GBS_VBLANK_CYCLES;
+    }
+    // TIMA overflow rate, bit 7 of the header TAC asks for CGB double speed
+    const uint32_t timerCycles[] = {1024, 16, 64, 256};
+    uint32_t period = (256 - mmu->tma) * timerCycles[mmu->tac & 0x03];
+    if (player->header.timerControl & 0x80) {
+        period /= 2;
+    }
+    return period;
+}
+
+// Runs the routine at `addr` until it returns, returns the cycles it took
+uint32_t _GBSPlayerCall(GBSPlayer* player, Word addr) {
+    GB_device* device = player->device;
+    GB_cpu* cpu = &device->cpu;
+
+    cpu->registers.sp -= 2;
+    GB_deviceWriteWord(device, cpu->registers.sp, GBS_RETURN_ADDRESS);
+    cpu->registers.pc = addr;
+    cpu->is_halted = false;
+
+    uint32_t elapsed = 0;
+    while (cpu->registers.pc != GBS_RETURN_ADDRESS) {
+        elapsed += GB_deviceCpuStep(device);
+        if (elapsed >= GBS_CALL_MAX_CYCLES) {
+            GBprintf("GBS: routine at %04x did not return\n", addr);
+            cpu->registers.pc = GBS_RETURN_ADDRESS;
+            break;
+        }
+    }
+    return elapsed;
+}
+
+bool GBSPlayerStartSong(GBSPlayer* player, uint8_t song) {
+    if (song >= player->header.songCount) {
+        return false;
+    }
+    GB_device* device = player->device;
+
+    GB_reset(device);
+    device->mmu.in_bios = false;
+    device->mmu.romBank = 1;
+
+    // power cycle the APU so no state leaks from the previous song
+    GB_deviceWriteByte(device, 0xFF26, 0x00);
+    GB_deviceWriteByte(device, 0xFF26, 0x80);
+    GB_deviceWriteByte(device, 0xFF25, 0xFF);
+    GB_deviceWriteByte(device, 0xFF24, 0x77);
+
+    GB_deviceWriteByte(device, 0xFF06, player->header.timerModulo);
+    GB_deviceWriteByte(device, 0xFF07, player->header.timerControl);
+
+    device->cpu.IME = false;
+    device->cpu.registers.sp = player->header.stackPointer;
+    device->cpu.registers.a = song;
+    player->currentSong = song;
+
+    _GBSPlayerCall(player, player->header.initAddress);
+    player->cyclesToPlay = GBSPlayerPlayPeriod(player);
+    return true;
+}
+
+void GBSPlayerRender(GBSPlayer* player, uint64_t cycles) {
+    int64_t remaining = (int64_t)cycles;
+    while (remaining > 0) {
+        if (player->cyclesToPlay <= 0) {
+            uint32_t used = _GBSPlayerCall(player, player->header.playAddress);
+            player->cyclesToPlay += GBSPlayerPlayPeriod(player) - (int64_t)used;
+            remaining -= used;
+            continue;
+        }
+
+        int64_t chunk = GBS_IDLE_CYCLES;
+        if (chunk > remaining) {
+            chunk = remaining;
+        }
+        if (chunk > player->cyclesToPlay) {
+            chunk = player->cyclesToPlay;
+        }
+        chunk = (chunk + 3) & ~3; // the machine advances in M-cycles
+        GB_emulationAdvance(player->device, (Byte)chunk);
+        remaining -= chunk;
+        player->cyclesToPlay -= chunk;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "definitions.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// GBS (Game Boy Sound System) music player.
+// The rip's code is mapped at its load address and driven like the game
+// would: init once per song, then the play routine at the timer or VBlank
+// rate. Only the CPU, timers and APU run, so a song renders into the APU
+// output ring (or a recorder) much faster than real time.
+
+#define GBS_HEADER_SIZE   0x70
+#define GBS_CPU_HZ        4194304
+#define GBS_VBLANK_CYCLES 70224
+// code returns here when a called routine executes its final RET
+#define GBS_RETURN_ADDRESS 0x0070
+// a routine still running after this long is treated as stuck
+#define GBS_CALL_MAX_CYCLES GBS_CPU_HZ
+
+struct GBSHeader_s {
+    Byte version;
+    Byte songCount;
+    Byte firstSong;     // 1-based, as stored in the file
+    Word loadAddress;
+    Word initAddress;
+    Word playAddress;
+    Word stackPointer;
+    Byte timerModulo;
+    Byte timerControl;
+    char title[33];
+    char author[33];
+    char copyright[33];
+};
+
+typedef struct GBSHeader_s GBSHeader;
+
+struct GBSPlayer_s {
+    GB_device* device;
+    GBSHeader header;
+    uint8_t currentSong;
+    // CPU cycles until the next play call
+    int64_t cyclesToPlay;
+};
+
+// Loads a .gbs file into `device`, which is reconfigured for playback only.
+// Returns NULL if the file can't be read or is not a GBS file.
+GBSPlayer* GBSPlayerOpen(GB_device* device, const char* filePath);
+void GBSPlayerFree(GBSPlayer* player);
+// Resets the machine and runs the init routine for `song` (0-based).
+bool GBSPlayerStartSong(GBSPlayer* player, uint8_t song);
+// Emulates `cycles` CPU cycles, calling the play routine at its rate.
+void GBSPlayerRender(GBSPlayer* player, uint64_t cycles);
+// CPU cycles between two play calls, from the current TMA/TAC values
+uint32_t GBSPlayerPlayPeriod(GBSPlayer* player);
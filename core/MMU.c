@@ -15,8 +15,8 @@ Byte GB_mmu_read_FF00(GB_mmu* mem, Word addr);
 void GB_mmu_write_FF00(GB_mmu* mem, Word addr, Byte value);
 Byte _GBJoypadByteRepresentation(GB_mmu* mem);
 
-Byte GB_deviceReadByte(GB_device* device, Word addr) {
-    GB_mmu* mem = device->mmu;
+static inline Byte _GB_deviceReadByte(GB_device* device, Word addr) {
+    GB_mmu* mem = &device->mmu;
     switch (addr & 0xF000) {
         // MARK: ROM bank or BIOS
         case 0x0000:
@@ -32,6 +32,9 @@ Byte GB_deviceReadByte(GB_device* device, Word addr) {
         case 0x1000: case 0x2000: case 0x3000:
             return mem->rom[addr];
         case 0x4000: case 0x5000: case 0x6000: case 0x7000:
+            if (mem->romBanking) {
+                return mem->rom[(uint32_t)mem->romBank * 0x4000 + (addr & 0x3FFF)];
+            }
             return mem->rom[addr]; //TODO: handle ROM Bank switch here
 
         // MARK: VRAM
@@ -56,7 +59,7 @@ Byte GB_deviceReadByte(GB_device* device, Word addr) {
                 case 0xE00:
                     // OAM is 0xA0 bytes, remaining bytes read as 0
                     if(addr < 0xFEA0) {
-                        return device->ppu->oam[addr & 0xFF];
+                        return device->ppu.oam[addr & 0xFF];
                     }
                     return 0;
                 		    // Zero-page
@@ -87,6 +90,13 @@ Byte GB_deviceReadByte(GB_device* device, Word addr) {
     return 0;
 }
 
+Byte GB_deviceReadByte(GB_device* device, Word addr) {
+    GB_PROFILE_ENTER(device, GBProfileMemory);
+    Byte value = _GB_deviceReadByte(device, addr);
+    GB_PROFILE_LEAVE(device);
+    return value;
+}
+
 Word GB_deviceReadWord(GB_device* device, Word addr) {
     Byte lower = GB_deviceReadByte(device, addr);
     Word strongByte = GB_deviceReadByte(device, addr+1);
@@ -94,18 +104,25 @@ Word GB_deviceReadWord(GB_device* device, Word addr) {
 }
 
 void GB_device_OAM_DMA(GB_device* device, Byte data) {
-    device->ppu->dmaValue = data;
+    device->ppu.dmaValue = data;
     Word addr = ((Word)data) * 0x100;
     for (int delta = 0; delta < 0xA0; delta++) {
         Word copyAddr = addr + delta;
-        device->ppu->oam[delta] = GB_deviceReadByte(device, copyAddr);
+        device->ppu.oam[delta] = GB_deviceReadByte(device, copyAddr);
     }
 }
 
-void GB_deviceWriteByte(GB_device* device, Word addr, Byte value) {
-    GB_mmu* mem = device->mmu;
+static inline void _GB_deviceWriteByte(GB_device* device, Word addr, Byte value) {
+    GB_mmu* mem = &device->mmu;
     switch (addr & 0xF000) {
-        case 0x0000: case 0x1000: case 0x2000: case 0x3000: case 0x4000:
+        case 0x2000: case 0x3000:
+            if (mem->romBanking) {
+                // wrap to the ROM size first, bank 0 never shows up at 0x4000
+                uint16_t bank = value % mem->romBankCount;
+                mem->romBank = bank == 0 ? 1 : bank;
+            }
+            break;
+        case 0x0000: case 0x1000: case 0x4000:
         case 0x5000: case 0x6000: case 0x7000:
             break; // TODO: Handle MBCs to define behavior
         case 0x8000: case 0x9000:
@@ -132,7 +149,7 @@ void GB_deviceWriteByte(GB_device* device, Word addr, Byte value) {
                 case 0xE00:
                     // OAM is 0xA0 bytes, remaining bytes read as 0
                     if(addr < 0xFEA0) {
-                        device->ppu->oam[addr & 0xFF] = value;
+                        device->ppu.oam[addr & 0xFF] = value;
                     }
                     break;
                 // Zero-page
@@ -166,12 +183,18 @@ void GB_deviceWriteByte(GB_device* device, Word addr, Byte value) {
     }
 }
 
+void GB_deviceWriteByte(GB_device* device, Word addr, Byte value) {
+    GB_PROFILE_ENTER(device, GBProfileMemory);
+    _GB_deviceWriteByte(device, addr, value);
+    GB_PROFILE_LEAVE(device);
+}
+
 void GB_deviceWriteWord(GB_device* device, Word addr, Word value) {
     GB_deviceWriteByte(device, addr, value & 0xff);
     GB_deviceWriteByte(device, addr + 1, value >> 8);
 }
 
-u_int32_t GB_cartridgeRomSize(u_int8_t rawRomSize) {
+uint32_t GB_cartridgeRomSize(uint8_t rawRomSize) {
     switch (rawRomSize)
     {
     case 0:
@@ -197,7 +220,7 @@ u_int32_t GB_cartridgeRomSize(u_int8_t rawRomSize) {
     };
 }
 
-u_int32_t GB_cartridgeRamSize(u_int8_t rawRamSize) {
+uint32_t GB_cartridgeRamSize(uint8_t rawRamSize) {
     switch (rawRamSize)
     {
     case 2:
@@ -216,7 +239,6 @@ u_int32_t GB_cartridgeRamSize(u_int8_t rawRamSize) {
 int GB_deviceloadRom(GB_device* device, const char* filePath) {
     FILE *cartridgeFile = fopen(filePath, "rb");
     if(cartridgeFile == NULL) {
-        fclose(cartridgeFile);
         return GB_CARTRIDGE_FILE_ERROR;
     }
 
@@ -230,28 +252,36 @@ int GB_deviceloadRom(GB_device* device, const char* filePath) {
         fclose(cartridgeFile);
         return GB_CARTRIDGE_FILE_ERROR;
     }
-    u_int8_t rawCartType;
+    uint8_t rawCartType;
     fread(&rawCartType, 1, 1, cartridgeFile);
     if(fseek(cartridgeFile, GB_CARTRIDGE_ROM_SIZE, SEEK_SET) != 0) {
         fclose(cartridgeFile);
         return GB_CARTRIDGE_FILE_ERROR;
     }
 
-    u_int8_t rawRomSize;
+    uint8_t rawRomSize;
     fread(&rawRomSize, 1, 1, cartridgeFile);
-    u_int32_t romSize = GB_cartridgeRomSize(rawRomSize);
+    uint32_t romSize = GB_cartridgeRomSize(rawRomSize);
     if(fseek(cartridgeFile, GB_CARTRIDGE_RAM_SIZE, SEEK_SET) != 0) {
         fclose(cartridgeFile);
         return GB_CARTRIDGE_FILE_ERROR;
     }
-    u_int8_t rawRamSize;
+    uint8_t rawRamSize;
     fread(&rawRamSize, 1, 1, cartridgeFile);
-    u_int32_t ramSize = GB_cartridgeRamSize(rawRamSize);
+    uint32_t ramSize = GB_cartridgeRamSize(rawRamSize);
 
-    device->mmu->rom = (u_int8_t *) malloc(romSize);
+    Byte* rom = malloc(romSize);
+    if (rom == NULL) {
+        fclose(cartridgeFile);
+        return GB_CARTRIDGE_FILE_ERROR;
+    }
+    GB_deviceReleaseRom(device);
+    device->mmu.rom = rom;
 
     fseek(cartridgeFile, 0, SEEK_SET);
-    fread(device->mmu->rom, romSize, 1, cartridgeFile);
+    fread(device->mmu.rom, romSize, 1, cartridgeFile);
+    device->mmu.romSize = romSize;
+    device->mmu.romHash = GB_romHash(device->mmu.rom, romSize);
 
     // Handle eRam sizes
 
@@ -259,6 +289,22 @@ int GB_deviceloadRom(GB_device* device, const char* filePath) {
     return GB_CARTRIDGE_SUCCESS;
 }
 
+void GB_deviceReleaseRom(GB_device* device) {
+    if (device->mmu.romShared == false) {
+        free(device->mmu.rom);
+    }
+    device->mmu.rom = NULL;
+    device->mmu.romShared = false;
+}
+
+uint64_t GB_romHash(const Byte* rom, uint32_t size) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (uint32_t i = 0; i < size; i++) {
+        hash = (hash ^ rom[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
 Byte GB_mmu_read_FF00(GB_mmu* mem, Word addr) {
     int localAddress = addr & 0xFF;
     
@@ -313,10 +359,11 @@ void GB_mmu_write_FF00(GB_mmu* mem, Word addr, Byte value) {
             break;
         case 0x02:
             mem->sc = value;
-            mem->period = 0x1000;
-            if (value & 0x80) {
-                mem->nextEvent = 0x1000;
-                // mem->remainingBits = 8;
+            // with an external clock the byte waits for a partner that never comes
+            if ((value & 0x81) == 0x81) {
+                mem->serialEventCycle = mem->cycleCount + GB_SERIAL_TRANSFER_CYCLES;
+            } else {
+                mem->serialEventCycle = GB_SERIAL_IDLE;
             }
             break;
         case 0x04:
@@ -348,8 +395,9 @@ void GB_mmu_write_FF00(GB_mmu* mem, Word addr, Byte value) {
 }
 
 void GB_deviceResetMMU(GB_device* device) {
-    GB_mmu* mem = device->mmu;
+    GB_mmu* mem = &device->mmu;
     mem->in_bios = true;
+    mem->romBank = 1;
     memcpy(mem->bios, GBDMGBios, GBDMGBiosLength);
     memset(mem->eRam, 0, 0x2000);
     memset(mem->wRam, 0, 0x2000);
@@ -367,8 +415,8 @@ void GB_deviceResetMMU(GB_device* device) {
     mem->KEY1 = 0;
     mem->timaCounter = 0;
     mem->joypadState = (GBJoypadState) { false, false, false, false, false, false, false, false };
-    mem->pendingSB = 0xFF;
-    mem->remainingBits = 8;
+    mem->cycleCount = 0;
+    mem->serialEventCycle = GB_SERIAL_IDLE;
 }
 
 Byte _GBJoypadByteRepresentation(GB_mmu* mem) {
@@ -390,50 +438,40 @@ Byte _GBJoypadByteRepresentation(GB_mmu* mem) {
 
 void GBUpdateJoypadState(GB_device* device, GBJoypadState joypad) {
     if (
-        joypad.aPressed != device->mmu->joypadState.aPressed ||
-        joypad.bPressed != device->mmu->joypadState.bPressed ||
-        joypad.startPressed != device->mmu->joypadState.startPressed ||
-        joypad.selectPressed != device->mmu->joypadState.selectPressed ||
-        joypad.rightPressed != device->mmu->joypadState.rightPressed ||
-        joypad.leftPressed != device->mmu->joypadState.leftPressed ||
-        joypad.upPressed != device->mmu->joypadState.upPressed ||
-        joypad.aPressed != device->mmu->joypadState.aPressed ||
-        joypad.downPressed != device->mmu->joypadState.downPressed
+        joypad.aPressed != device->mmu.joypadState.aPressed ||
+        joypad.bPressed != device->mmu.joypadState.bPressed ||
+        joypad.startPressed != device->mmu.joypadState.startPressed ||
+        joypad.selectPressed != device->mmu.joypadState.selectPressed ||
+        joypad.rightPressed != device->mmu.joypadState.rightPressed ||
+        joypad.leftPressed != device->mmu.joypadState.leftPressed ||
+        joypad.upPressed != device->mmu.joypadState.upPressed ||
+        joypad.aPressed != device->mmu.joypadState.aPressed ||
+        joypad.downPressed != device->mmu.joypadState.downPressed
         ) {
-        device->mmu->joypadState = joypad;
+        device->mmu.joypadState = joypad;
         GB_interrupt_request(device, GB_INTERRUPT_FLAG_JOYPAD);
     }
 }
 
 void GB_interrupt_request(GB_device *device, unsigned char ir) {
-    device->mmu->interruptRequest = (device->mmu->interruptRequest | ir) & 0x1f;
+    device->mmu.interruptRequest = (device->mmu.interruptRequest | ir) & 0x1f;
 }
 
-int32_t GBProcessMemEvents(GB_device* device, Byte cycles) {
-    if ((device->mmu->sc & 0x80) == 0) {
-        return 0;
-    }
-    if (device->mmu->nextEvent != 2147483647) {
- 		device->mmu->nextEvent -= cycles;
- 	}
+void GBSerialSetByteCallback(GB_device* device, GBSerialByteCallback callback, void* sender) {
+    device->serialCallback = callback;
+    device->serialCallbackSender = sender;
+}
 
- 	if (device->mmu->nextEvent <= 0) {
- 		--device->mmu->remainingBits;
- 		device->mmu->sb &= ~(8 >> device->mmu->remainingBits);
- 		device->mmu->sb |= device->mmu->pendingSB & ~(8 >> device->mmu->remainingBits);
- 		if (!device->mmu->remainingBits) {
-            GB_interrupt_request(device, GB_INTERRUPT_FLAG_SERIAL);
- 			device->mmu->sc = device->mmu->sc & 0x80;
- 			device->mmu->nextEvent = 2147483647;
-            if (device->mmu->pendingSB == 0xff) {
-                device->mmu->pendingSB = 0x01;
-                device->mmu->remainingBits = 8;
-            }
- 		} else {
- 			device->mmu->nextEvent += device->mmu->period;
- 		}
- 	}
- 	return device->mmu->nextEvent;
+void GBSerialTransferComplete(GB_device* device) {
+    GB_mmu* mem = &device->mmu;
+    Byte value = mem->sb;
+    mem->sb = 0xFF;
+    mem->sc &= 0x7F;
+    mem->serialEventCycle = GB_SERIAL_IDLE;
+    GB_interrupt_request(device, GB_INTERRUPT_FLAG_SERIAL);
+    if (device->serialCallback != NULL) {
+        device->serialCallback(device->serialCallbackSender, device, value);
+    }
 }
 
 //GBJoypadState GBJoypadStateDefault() { return (GBJoypadState) { false, false, false, false, false, false, false, false }; }
\ No newline at end of file
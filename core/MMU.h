@@ -12,6 +12,11 @@
 #define GB_CARTRIDGE_ROM_SIZE 0x0148
 #define GB_CARTRIDGE_RAM_SIZE 0x0149
 
+// internal clock shifts at 8192 Hz, a whole byte takes 8 bits of 512 cycles
+#define GB_SERIAL_TRANSFER_CYCLES 4096
+// serialEventCycle when no transfer is in flight
+#define GB_SERIAL_IDLE UINT64_MAX
+
 typedef enum {
     GBTimaClockCycles256,
     GBTimaClockCycles4,
@@ -44,13 +49,16 @@ struct GBJoypadState_s {
 typedef struct GBJoypadState_s GBJoypadState;
 
 struct GB_mmu_s {
+    // registers and ROM mapping first, they are touched on every access;
+    // the RAM arrays follow
     bool in_bios;
-
-    Byte bios[0x100];
     Byte* rom; // TODO: handle multiple rom sizes
-    Byte eRam[0x2000];
-    Byte wRam[0x2000];
-    Byte zRam[0x80];
+    // borrowed from the device this one was copied from, never freed here
+    bool romShared;
+    // MBC1 style switching of 0x4000-0x7FFF, only used by GBS images for now
+    bool romBanking;
+    uint16_t romBank;
+    uint16_t romBankCount;
 
     Byte sb;
     Byte sc;
@@ -70,12 +78,19 @@ struct GB_mmu_s {
     bool joypadButtonSelected;
     GBJoypadState joypadState;
 
-    // WIP
-    int32_t nextEvent;
- 	int32_t period;
- 	int remainingBits;
+    // cycles run since reset, the time base for scheduled events
+    uint64_t cycleCount;
+    // cycleCount at which the serial byte in flight completes
+    uint64_t serialEventCycle;
 
- 	uint8_t pendingSB;
+    uint32_t romSize;
+    // FNV-1a of the ROM image, identifies the game in save states
+    uint64_t romHash;
+
+    Byte bios[0x100];
+    Byte eRam[0x2000];
+    Byte wRam[0x2000];
+    Byte zRam[0x80];
 };
 
 Byte GB_deviceReadByte(GB_device*, Word);
@@ -83,7 +98,15 @@ Word GB_deviceReadWord(GB_device*, Word);
 void GB_deviceWriteByte(GB_device*, Word, Byte);
 void GB_deviceWriteWord(GB_device*, Word, Word);
 int  GB_deviceloadRom(GB_device* device, const char* filePath);
+void GB_deviceReleaseRom(GB_device* device);
 void GB_deviceResetMMU(GB_device* device);
 void GB_interrupt_request(GB_device* device, Byte ir);
 void GBUpdateJoypadState(GB_device* device, GBJoypadState joypad);
-int32_t GBProcessMemEvents(GB_device* device, Byte cycles);
\ No newline at end of file
+uint64_t GB_romHash(const Byte* rom, uint32_t size);
+// Receives every byte the game shifts out over the serial port on its
+// internal clock, at the cycle the transfer completes. There is no link
+// partner: the game always reads back 0xFF.
+typedef void (*GBSerialByteCallback)(void* sender, GB_device* device, Byte value);
+void GBSerialSetByteCallback(GB_device* device, GBSerialByteCallback callback, void* sender);
+// Called by GB_emulationAdvance once serialEventCycle is reached
+void GBSerialTransferComplete(GB_device* device);
\ No newline at end of file
@@ -0,0 +1,384 @@
+#include "Movie.h"
+#include "Device.h"
+#include "Rewind.h"
+#include "SaveState.h"
+#include "Helper.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// MARK: Input packing
+
+// P1 order: right/A, left/B, up/select, down/start
+Byte _GBMoviePackJoypad(GBJoypadState joypad) {
+    return (joypad.rightPressed  ? 0x01 : 0) |
+           (joypad.leftPressed   ? 0x02 : 0) |
+           (joypad.upPressed     ? 0x04 : 0) |
+           (joypad.downPressed   ? 0x08 : 0) |
+           (joypad.aPressed      ? 0x10 : 0) |
+           (joypad.bPressed      ? 0x20 : 0) |
+           (joypad.selectPressed ? 0x40 : 0) |
+           (joypad.startPressed  ? 0x80 : 0);
+}
+
+GBJoypadState _GBMovieUnpackJoypad(Byte buttons) {
+    GBJoypadState joypad;
+    memset(&joypad, 0, sizeof(joypad));
+    joypad.rightPressed  = (buttons & 0x01) != 0;
+    joypad.leftPressed   = (buttons & 0x02) != 0;
+    joypad.upPressed     = (buttons & 0x04) != 0;
+    joypad.downPressed   = (buttons & 0x08) != 0;
+    joypad.aPressed      = (buttons & 0x10) != 0;
+    joypad.bPressed      = (buttons & 0x20) != 0;
+    joypad.selectPressed = (buttons & 0x40) != 0;
+    joypad.startPressed  = (buttons & 0x80) != 0;
+    return joypad;
+}
+
+// MARK: Storage
+
+bool _GBMovieGrow(void** items, uint32_t* capacity, uint32_t count, size_t itemSize) {
+    if (count < *capacity) {
+        return true;
+    }
+    uint32_t newCapacity = *capacity == 0 ? 64 : *capacity * 2;
+    void* grown = realloc(*items, newCapacity * itemSize);
+    if (grown == NULL) {
+        return false;
+    }
+    *items = grown;
+    *capacity = newCapacity;
+    return true;
+}
+
+bool _GBMovieAppendRun(GBMovie* movie, Byte buttons, uint32_t length) {
+    if (movie->runCount > 0 && movie->runs[movie->runCount - 1].buttons == buttons) {
+        movie->runs[movie->runCount - 1].length += length;
+        return true;
+    }
+    if (!_GBMovieGrow((void**)&movie->runs, &movie->runCapacity, movie->runCount, sizeof(GBMovieRun))) {
+        return false;
+    }
+    uint32_t start = movie->runCount > 0
+        ? movie->runs[movie->runCount - 1].startFrame + movie->runs[movie->runCount - 1].length
+        : 0;
+    movie->runs[movie->runCount++] = (GBMovieRun){start, length, buttons};
+    return true;
+}
+
+bool _GBMovieAppendKeyframe(GBMovie* movie, uint32_t frame, const Byte* data, uint32_t size) {
+    if (!_GBMovieGrow((void**)&movie->keyframes, &movie->keyframeCapacity, movie->keyframeCount, sizeof(GBMovieKeyframe))) {
+        return false;
+    }
+    if (movie->keyframeDataSize + size > movie->keyframeDataCapacity) {
+        size_t capacity = movie->keyframeDataCapacity == 0 ? 0x10000 : movie->keyframeDataCapacity;
+        while (capacity < movie->keyframeDataSize + size) {
+            capacity *= 2;
+        }
+        Byte* grown = realloc(movie->keyframeData, capacity);
+        if (grown == NULL) {
+            return false;
+        }
+        movie->keyframeData = grown;
+        movie->keyframeDataCapacity = capacity;
+    }
+    memcpy(movie->keyframeData + movie->keyframeDataSize, data, size);
+    movie->keyframes[movie->keyframeCount++] = (GBMovieKeyframe){frame, movie->keyframeDataSize, size};
+    movie->keyframeDataSize += size;
+    return true;
+}
+
+bool _GBMovieCaptureKeyframe(GBMovie* movie) {
+    if (GB_saveStateToBuffer(movie->device, movie->state, movie->stateSize) != (long)movie->stateSize) {
+        return false;
+    }
+    size_t size = GBRewindEncode(movie->state, NULL, movie->stateSize, movie->scratch);
+    return _GBMovieAppendKeyframe(movie, movie->currentFrame, movie->scratch, (uint32_t)size);
+}
+
+// Drops the input and keyframes after the current frame
+void _GBMovieTruncate(GBMovie* movie) {
+    uint32_t end = movie->currentFrame;
+    while (movie->runCount > 0 && movie->runs[movie->runCount - 1].startFrame >= end) {
+        movie->runCount--;
+    }
+    if (movie->runCount > 0) {
+        GBMovieRun* last = &movie->runs[movie->runCount - 1];
+        if (last->startFrame + last->length > end) {
+            last->length = end - last->startFrame;
+        }
+    }
+    while (movie->keyframeCount > 0 && movie->keyframes[movie->keyframeCount - 1].frame > end) {
+        movie->keyframeCount--;
+        movie->keyframeDataSize = movie->keyframes[movie->keyframeCount].offset;
+    }
+    movie->frameCount = end;
+}
+
+// Run holding `frame`, which must be below the frame count
+GBMovieRun* _GBMovieFindRun(GBMovie* movie, uint32_t frame) {
+    uint32_t low = 0;
+    uint32_t high = movie->runCount;
+    while (high - low > 1) {
+        uint32_t middle = (low + high) / 2;
+        if (movie->runs[middle].startFrame <= frame) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return &movie->runs[low];
+}
+
+GBMovie* _GBMovieAlloc(GB_device* device, uint32_t keyframeInterval) {
+    GBMovie* movie = malloc(sizeof(GBMovie));
+    if (movie == NULL) {
+        return NULL;
+    }
+    memset(movie, 0, sizeof(GBMovie));
+    movie->device = device;
+    movie->romHash = device->mmu.romHash;
+    movie->keyframeInterval = keyframeInterval == 0 ? GB_MOVIE_DEFAULT_KEYFRAME_INTERVAL : keyframeInterval;
+    movie->stateSize = GB_saveStateSize(device);
+    movie->state = malloc(movie->stateSize);
+    movie->scratch = malloc(GBRewindEncodeBound(movie->stateSize));
+    if (movie->state == NULL || movie->scratch == NULL) {
+        GBMovieFree(movie);
+        return NULL;
+    }
+    return movie;
+}
+
+// MARK: Recording and playback
+
+GBMovie* GBMovieCreate(GB_device* device, uint32_t keyframeInterval) {
+    GBMovie* movie = _GBMovieAlloc(device, keyframeInterval);
+    if (movie == NULL) {
+        return NULL;
+    }
+    if (!_GBMovieCaptureKeyframe(movie)) {
+        GBMovieFree(movie);
+        return NULL;
+    }
+    return movie;
+}
+
+void GBMovieFree(GBMovie* movie) {
+    if (movie == NULL) {
+        return;
+    }
+    free(movie->runs);
+    free(movie->keyframes);
+    free(movie->keyframeData);
+    free(movie->state);
+    free(movie->scratch);
+    free(movie);
+}
+
+bool GBMovieRecordFrame(GBMovie* movie, GBJoypadState joypad) {
+    if (movie->currentFrame < movie->frameCount) {
+        _GBMovieTruncate(movie);
+    }
+    // state at the start of the frame, before its input
+    bool hasKeyframe = movie->keyframeCount > 0 && movie->keyframes[movie->keyframeCount - 1].frame == movie->currentFrame;
+    if (movie->currentFrame % movie->keyframeInterval == 0 && hasKeyframe == false &&
+        !_GBMovieCaptureKeyframe(movie)) {
+        return false;
+    }
+    if (!_GBMovieAppendRun(movie, _GBMoviePackJoypad(joypad), 1)) {
+        return false;
+    }
+    movie->frameCount++;
+    movie->currentFrame++;
+    GBUpdateJoypadState(movie->device, joypad);
+    return true;
+}
+
+bool GBMoviePlayFrame(GBMovie* movie) {
+    if (movie->currentFrame >= movie->frameCount) {
+        return false;
+    }
+    GBMovieRun* run = _GBMovieFindRun(movie, movie->currentFrame);
+    GBUpdateJoypadState(movie->device, _GBMovieUnpackJoypad(run->buttons));
+    movie->currentFrame++;
+    return true;
+}
+
+bool _GBMovieLoadKeyframe(GBMovie* movie, uint32_t index) {
+    GBMovieKeyframe* keyframe = &movie->keyframes[index];
+    if (!GBRewindDecode(movie->keyframeData + keyframe->offset, keyframe->size, movie->state, movie->stateSize, true) ||
+        GB_loadStateFromBuffer(movie->device, movie->state, movie->stateSize) != GB_STATE_SUCCESS) {
+        return false;
+    }
+    movie->currentFrame = keyframe->frame;
+    return true;
+}
+
+bool GBMovieSeek(GBMovie* movie, uint32_t frame) {
+    if (frame > movie->frameCount || movie->keyframeCount == 0) {
+        return false;
+    }
+    uint32_t key = 0;
+    for (uint32_t i = movie->keyframeCount; i > 0; i--) {
+        if (movie->keyframes[i - 1].frame <= frame) {
+            key = i - 1;
+            break;
+        }
+    }
+    // already between that keyframe and the target: just play forward
+    bool playForward = movie->currentFrame <= frame && movie->currentFrame >= movie->keyframes[key].frame;
+    if (playForward == false && !_GBMovieLoadKeyframe(movie, key)) {
+        return false;
+    }
+    if (movie->currentFrame == frame) {
+        return true;
+    }
+
+    // replayed in the device's own audio mode: switching to headless and back
+    // would restart the square and noise generators, and the state would no
+    // longer match the recording byte for byte
+    while (movie->currentFrame < frame) {
+        GBMoviePlayFrame(movie);
+        GB_runFrame(movie->device);
+    }
+    return true;
+}
+
+uint32_t GBMovieFrameCount(GBMovie* movie) {
+    return movie->frameCount;
+}
+
+uint32_t GBMovieCurrentFrame(GBMovie* movie) {
+    return movie->currentFrame;
+}
+
+// MARK: File
+
+void _GBMoviePut32(Byte* out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (value >> (8 * i)) & 0xFF;
+    }
+}
+
+uint32_t _GBMovieGet32(const Byte* in) {
+    return (uint32_t)in[0] | (uint32_t)in[1] << 8 | (uint32_t)in[2] << 16 | (uint32_t)in[3] << 24;
+}
+
+int GBMovieSave(GBMovie* movie, const char* filePath) {
+    FILE* file = fopen(filePath, "wb");
+    if (file == NULL) {
+        return GB_STATE_FILE_ERROR;
+    }
+
+    Byte header[32];
+    memcpy(header, GB_MOVIE_MAGIC, 4);
+    _GBMoviePut32(header + 4, GB_MOVIE_VERSION);
+    _GBMoviePut32(header + 8, (uint32_t)movie->romHash);
+    _GBMoviePut32(header + 12, (uint32_t)(movie->romHash >> 32));
+    _GBMoviePut32(header + 16, movie->frameCount);
+    _GBMoviePut32(header + 20, movie->keyframeInterval);
+    _GBMoviePut32(header + 24, (uint32_t)movie->stateSize);
+    _GBMoviePut32(header + 28, movie->runCount);
+    bool ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+
+    for (uint32_t i = 0; i < movie->runCount && ok; i++) {
+        Byte run[5];
+        run[0] = movie->runs[i].buttons;
+        _GBMoviePut32(run + 1, movie->runs[i].length);
+        ok = fwrite(run, 1, sizeof(run), file) == sizeof(run);
+    }
+
+    Byte count[4];
+    _GBMoviePut32(count, movie->keyframeCount);
+    ok = ok && fwrite(count, 1, sizeof(count), file) == sizeof(count);
+    for (uint32_t i = 0; i < movie->keyframeCount && ok; i++) {
+        GBMovieKeyframe* keyframe = &movie->keyframes[i];
+        Byte keyframeHeader[8];
+        _GBMoviePut32(keyframeHeader, keyframe->frame);
+        _GBMoviePut32(keyframeHeader + 4, keyframe->size);
+        ok = fwrite(keyframeHeader, 1, sizeof(keyframeHeader), file) == sizeof(keyframeHeader) &&
+             fwrite(movie->keyframeData + keyframe->offset, 1, keyframe->size, file) == keyframe->size;
+    }
+
+    if (fclose(file) != 0 || ok == false) {
+        return GB_STATE_FILE_ERROR;
+    }
+    return GB_STATE_SUCCESS;
+}
+
+bool _GBMovieParse(GBMovie* movie, const Byte* data, size_t size) {
+    const Byte* end = data + size;
+    if (size < 32 || memcmp(data, GB_MOVIE_MAGIC, 4) != 0 || _GBMovieGet32(data + 4) != GB_MOVIE_VERSION) {
+        return false;
+    }
+    uint64_t romHash = _GBMovieGet32(data + 8) | (uint64_t)_GBMovieGet32(data + 12) << 32;
+    if (romHash != movie->romHash) {
+        GBprintf("Movie: recorded with another ROM\n");
+        return false;
+    }
+    uint32_t frameCount = _GBMovieGet32(data + 16);
+    movie->keyframeInterval = _GBMovieGet32(data + 20);
+    if (_GBMovieGet32(data + 24) != movie->stateSize || movie->keyframeInterval == 0) {
+        return false;
+    }
+    uint32_t runCount = _GBMovieGet32(data + 28);
+    const Byte* in = data + 32;
+
+    if ((size_t)(end - in) / 5 < runCount) {
+        return false;
+    }
+    for (uint32_t i = 0; i < runCount; i++, in += 5) {
+        if (!_GBMovieAppendRun(movie, in[0], _GBMovieGet32(in + 1))) {
+            return false;
+        }
+    }
+    GBMovieRun* last = movie->runCount > 0 ? &movie->runs[movie->runCount - 1] : NULL;
+    if ((last != NULL ? last->startFrame + last->length : 0) != frameCount) {
+        return false;
+    }
+    movie->frameCount = frameCount;
+
+    if (end - in < 4) {
+        return false;
+    }
+    uint32_t keyframeCount = _GBMovieGet32(in);
+    in += 4;
+    for (uint32_t i = 0; i < keyframeCount; i++) {
+        if (end - in < 8) {
+            return false;
+        }
+        uint32_t frame = _GBMovieGet32(in);
+        uint32_t keyframeSize = _GBMovieGet32(in + 4);
+        in += 8;
+        bool ordered = i == 0 ? frame == 0 : frame > movie->keyframes[i - 1].frame;
+        if (ordered == false || frame > frameCount || keyframeSize > (size_t)(end - in) ||
+            !_GBMovieAppendKeyframe(movie, frame, in, keyframeSize)) {
+            return false;
+        }
+        in += keyframeSize;
+    }
+    return movie->keyframeCount > 0;
+}
+
+GBMovie* GBMovieLoad(GB_device* device, const char* filePath) {
+    FILE* file = fopen(filePath, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    Byte* data = NULL;
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0) {
+        data = malloc(size);
+    }
+    bool read = data != NULL && fread(data, 1, size, file) == (size_t)size;
+    fclose(file);
+
+    GBMovie* movie = read ? _GBMovieAlloc(device, 0) : NULL;
+    if (movie == NULL || !_GBMovieParse(movie, data, size) || !_GBMovieLoadKeyframe(movie, 0)) {
+        GBprintf("Movie: %s is not a valid movie for this ROM\n", filePath);
+        GBMovieFree(movie);
+        movie = NULL;
+    }
+    free(data);
+    return movie;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "definitions.h"
+#include "MMU.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Input movies.
+// The joypad state of every frame is recorded as runs of identical input.
+// The state at the start of frame 0 and then of every `keyframeInterval`th
+// frame is embedded (zero-run encoded save states), so seeking loads the
+// nearest keyframe and replays at most `keyframeInterval` frames, headless
+// when the device is.
+// While a movie records or plays, input must only reach the device through
+// it, once per frame, right after the previous frame completed (GB_runFrame).
+//
+// File: "NBMV", version, ROM hash, frame count, keyframe interval, state
+// size, runs (buttons, length), keyframes (frame, size, data), little-endian.
+
+#define GB_MOVIE_MAGIC   "NBMV"
+#define GB_MOVIE_VERSION 1
+#define GB_MOVIE_DEFAULT_KEYFRAME_INTERVAL 300
+
+struct GBMovieRun_s {
+    uint32_t startFrame;
+    uint32_t length;
+    Byte buttons;
+};
+
+typedef struct GBMovieRun_s GBMovieRun;
+
+struct GBMovieKeyframe_s {
+    uint32_t frame;
+    size_t offset;
+    uint32_t size;
+};
+
+typedef struct GBMovieKeyframe_s GBMovieKeyframe;
+
+struct GBMovie_s {
+    GB_device* device;
+    uint64_t romHash;
+    uint32_t keyframeInterval;
+    // frames with recorded input
+    uint32_t frameCount;
+    // next frame to record or play
+    uint32_t currentFrame;
+
+    GBMovieRun* runs;
+    uint32_t runCount;
+    uint32_t runCapacity;
+
+    GBMovieKeyframe* keyframes;
+    uint32_t keyframeCount;
+    uint32_t keyframeCapacity;
+    Byte* keyframeData;
+    size_t keyframeDataSize;
+    size_t keyframeDataCapacity;
+
+    // raw state and encoder output
+    size_t stateSize;
+    Byte* state;
+    Byte* scratch;
+};
+
+// Starts a recording from the current state of `device`
+GBMovie* GBMovieCreate(GB_device* device, uint32_t keyframeInterval);
+// `device` must have the movie's ROM loaded, it is left at frame 0
+GBMovie* GBMovieLoad(GB_device* device, const char* filePath);
+int GBMovieSave(GBMovie* movie, const char* filePath);
+void GBMovieFree(GBMovie* movie);
+
+// Records and applies the input of the current frame. Recording from the
+// middle of a movie drops everything after that point. Returns false, with
+// nothing recorded or applied, if the input or the frame's keyframe could
+// not be stored: a movie missing it would no longer seek, so the caller
+// should stop recording.
+bool GBMovieRecordFrame(GBMovie* movie, GBJoypadState joypad);
+// Applies the recorded input of the current frame, false at the end
+bool GBMoviePlayFrame(GBMovie* movie);
+// Puts the device at the start of `frame` (at most the frame count)
+bool GBMovieSeek(GBMovie* movie, uint32_t frame);
+uint32_t GBMovieFrameCount(GBMovie* movie);
+uint32_t GBMovieCurrentFrame(GBMovie* movie);
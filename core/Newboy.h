@@ -3,4 +3,11 @@
 #include "APU.h"
 #include "MMU.h"
 #include "CPU.h"
-#include "PPU.h"
\ No newline at end of file
+#include "PPU.h"
+#include "GBSPlayer.h"
+#include "SaveState.h"
+#include "Rewind.h"
+#include "DevicePool.h"
+#include "Movie.h"
+#include "RunAhead.h"
+#include "FrameHash.h"
\ No newline at end of file
@@ -2,14 +2,12 @@
 #include "PPU.h"
 #include "MMU.h"
 #include "Device.h"
-#include <Security/cssmconfig.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
 #include <stdbool.h>
-#include <sys/_types/_u_int32_t.h>
 #include "CPU.h"
 
 #define CLOCK_INC 2
@@ -21,9 +19,10 @@ void GB_RenderProcessFrame(GB_device* device, Byte cycles);
 void GB_updateBackgroundPixel(GB_device* device, Byte line, Byte xScan);
 void GB_ClearFrame(GB_device* device);
 void GB_updateWindowPixel(GB_device* device, Byte line, Byte xScan);
+void _GB_ppu_decode_tile_row(GB_ppu* ppu, Word normalized_index);
 
 void GB_devicePPUstep(GB_device* device, Byte cycle) {
-    GB_ppu *ppu = device->ppu;
+    GB_ppu *ppu = &device->ppu;
     Byte tick = cycle / 4;
 
     bool sendStatInterrupt = false;
@@ -49,7 +48,7 @@ void GB_devicePPUstep(GB_device* device, Byte cycle) {
                         }
                     }
                 } else {
-                    u_int32_t newClock = ppu->clock + CLOCK_INC;
+                    uint32_t newClock = ppu->clock + CLOCK_INC;
                     ppu->clock = newClock;
                 }
                 break;
@@ -60,7 +59,9 @@ void GB_devicePPUstep(GB_device* device, Byte cycle) {
                     ppu->line++;
                     if(ppu->line == 154) {
                         // End of vBlank goto OAM scan
-                        GB_ClearFrame(device);
+                        if (device->ppuSkipPixels == false) {
+                            GB_ClearFrame(device);
+                        }
                         ppu->lineMode = GB_PPU_MODE_OAM_SCAN;
                         ppu->line = 0;
                         if (ppu->isMode2InterruptEnabled) {
@@ -71,7 +72,7 @@ void GB_devicePPUstep(GB_device* device, Byte cycle) {
                         sendStatInterrupt = true;
                     }
                 } else {
-                    u_int32_t newClock = ppu->clock + CLOCK_INC;
+                    uint32_t newClock = ppu->clock + CLOCK_INC;
                     ppu->clock = newClock;
                 }
                 break;
@@ -80,13 +81,13 @@ void GB_devicePPUstep(GB_device* device, Byte cycle) {
                     ppu->clock = 0;
                     ppu->lineMode = GB_PPU_MODE_DRAW;
                 }  else {
-                    u_int32_t newClock = ppu->clock + CLOCK_INC;
+                    uint32_t newClock = ppu->clock + CLOCK_INC;
                     ppu->clock = newClock;
                 }
                 break;
             case GB_PPU_MODE_DRAW:
                 GB_RenderProcessFrame(device, cycle);
-                u_int32_t newClock = ppu->clock + CLOCK_INC;
+                uint32_t newClock = ppu->clock + CLOCK_INC;
                 ppu->clock = newClock;
         }
         if (sendStatInterrupt) {
@@ -96,16 +97,16 @@ void GB_devicePPUstep(GB_device* device, Byte cycle) {
 }
 
 void GB_ClearFrame(GB_device* device) {
-    memset(device->ppu->objPriorities, 0, 160 * 144);
-    memset(device->ppu->frameBuffer[GBObjectFrameBuffer], 0, sizeof(GBObjectFrameBuffer) * 160 * 144);
+    memset(device->ppu.objPriorities, 0, 160 * 144);
+    memset(device->ppu.frameBuffer[GBObjectFrameBuffer], 0, sizeof(GBObjectFrameBuffer) * 160 * 144);
 }
 
 Byte GB_deviceVramRead(GB_device* device, Word addr) {
-    return device->ppu->vRam[addr & 0x1FFF]; // TODO: handle switch for CGB
+    return device->ppu.vRam[addr & 0x1FFF]; // TODO: handle switch for CGB
 }
 
 void GB_deviceVramWrite(GB_device* device, Word addr, Byte data) {
-    GB_ppu *ppu = device->ppu;
+    GB_ppu *ppu = &device->ppu;
     
     Word localAddr = addr & 0x1FFF;
     ppu->vRam[localAddr] = data;
@@ -115,8 +116,16 @@ void GB_deviceVramWrite(GB_device* device, Word addr, Byte data) {
     }
     // Update tile data on the fly to ease the rendering process
     // For example: `12 & 0xFFFE == 12` and `13 & 0xFFFE == 12`
-    Word normalized_index = localAddr & 0xFFFE;
+    _GB_ppu_decode_tile_row(ppu, localAddr & 0xFFFE);
+}
+
+void GB_ppuRebuildTiles(GB_device* device) {
+    for (Word addr = 0; addr < 0x1800; addr += 2) {
+        _GB_ppu_decode_tile_row(&device->ppu, addr);
+    }
+}
 
+void _GB_ppu_decode_tile_row(GB_ppu* ppu, Word normalized_index) {
     Byte byte1 = ppu->vRam[normalized_index];
     Byte byte2 = ppu->vRam[normalized_index + 1];
 
@@ -164,7 +173,7 @@ Byte GB_ppu_status_value(GB_ppu* ppu) {
 }
 
 void GB_devicePPUIOWrite(GB_device* device, Word addr, Byte data) {
-    GB_ppu* ppu = device->ppu;
+    GB_ppu* ppu = &device->ppu;
     Word localAddr = addr & 0x4F;
     switch (localAddr) {
         case 0x40:
@@ -220,7 +229,7 @@ void GB_devicePPUIOWrite(GB_device* device, Word addr, Byte data) {
 }
 
 Byte GB_devicePPUIORead(GB_device* device, Word addr) {
-    GB_ppu* ppu = device->ppu;
+    GB_ppu* ppu = &device->ppu;
     Word localAddr = addr & 0x4F;
     switch (localAddr) {
         case 0x40:
@@ -305,10 +314,10 @@ GBNonCBGColors GBNonCBGColors_value_from_int(int value) {
 }
 
 void GB_deviceResetPPU(GB_device* device) {
-    GB_ppu* ppu = device->ppu;
+    GB_ppu* ppu = &device->ppu;
     memset(ppu->vRam, 0, 0x2000);
     memset(ppu->oam, 0, 0xA0);
-    memset(ppu->tiles, 0, 384 * 8 * 8);
+    memset(ppu->tiles, 0, sizeof(ppu->tiles));
 
    memset(ppu->objPriorities, 0, 160 * 144);
 
@@ -321,9 +330,9 @@ void GB_deviceResetPPU(GB_device* device) {
     ppu->windowY  = 0;
     ppu->windowX  = 0;
 
-    memset(ppu->bgpIdColors,  0, 4);
-    memset(ppu->objp0IdColor, 0, 4);
-    memset(ppu->objp1IdColor, 0, 4);
+    memset(ppu->bgpIdColors,  0, sizeof(ppu->bgpIdColors));
+    memset(ppu->objp0IdColor, 0, sizeof(ppu->objp0IdColor));
+    memset(ppu->objp1IdColor, 0, sizeof(ppu->objp1IdColor));
 
     ppu->bgpIdColors[0] = GBNonCBGColorWhite;
     ppu->bgpIdColors[1] = GBNonCBGColorLightGray;
@@ -431,31 +440,31 @@ void setShort(char* tab, int startIdx, short value) {
 
 void GB_updateBackgroundPixel(GB_device* device, Byte line, Byte xScan) {
     uint32_t frameIndex = ((uint32_t)line * 160) + xScan;
-    if (device->ppu->isBGWinEnabled == false) {
+    if (device->ppu.isBGWinEnabled == false) {
         // window and background disabled set pixel to white
-        device->ppu->frameBuffer[GBBackgroundFrameBuffer][frameIndex] = GB_Tile_pixel_0;
+        device->ppu.frameBuffer[GBBackgroundFrameBuffer][frameIndex] = GB_Tile_pixel_0;
         return;
     }
-    Word scx = device->ppu->scrollX;
-    Word scy = device->ppu->scrollY;
+    Word scx = device->ppu.scrollX;
+    Word scy = device->ppu.scrollY;
 
-    u_int32_t pixelX = (xScan + scx) % 256;
-    u_int32_t pixelY = (line + scy) % 256;
+    uint32_t pixelX = (xScan + scx) % 256;
+    uint32_t pixelY = (line + scy) % 256;
     Byte tilex = pixelX / 8;
     Byte tiley = pixelY / 8;
-    uint32 bgPixelOffset = (tiley * 32) + tilex;
+    uint32_t bgPixelOffset = (tiley * 32) + tilex;
 
     uint16_t tileIndex = _GB_backgroundTileindexWithOffset(device, bgPixelOffset);
     uint32_t column = pixelX % 8;
     uint32_t row  = pixelY % 8;
-    GB_tile_pixel_value value = device->ppu->tiles[tileIndex][row][column];
-    device->ppu->frameBuffer[GBBackgroundFrameBuffer][frameIndex] = value;
+    GB_tile_pixel_value value = device->ppu.tiles[tileIndex][row][column];
+    device->ppu.frameBuffer[GBBackgroundFrameBuffer][frameIndex] = value;
 }
 
 void GB_updateWindowPixel(GB_device* device, Byte line, Byte xScan) {
-    if (device->ppu->isWindowEnabled == false) {
+    if (device->ppu.isWindowEnabled == false) {
         return;
-    } else if (xScan + 7 < device->ppu->windowX || line < device->ppu->windowY) {
+    } else if (xScan + 7 < device->ppu.windowX || line < device->ppu.windowY) {
         return;
     }
 
@@ -464,35 +473,35 @@ void GB_updateWindowPixel(GB_device* device, Byte line, Byte xScan) {
     }
 
     uint32_t frameIndex = ((uint32_t)line * 160) + xScan;
-    Word scx = device->ppu->windowX;
-    Word scy = device->ppu->windowY;
+    Word scx = device->ppu.windowX;
+    Word scy = device->ppu.windowY;
 
-    u_int32_t pixelX = (xScan  + 7) - scx;
-    u_int32_t pixelY = line + scy;
+    uint32_t pixelX = (xScan  + 7) - scx;
+    uint32_t pixelY = line + scy;
     Byte tilex = pixelX / 8;
     Byte tiley = pixelY / 8;
-    uint32 bgPixelOffset = (tiley * 32) + tilex;
+    uint32_t bgPixelOffset = (tiley * 32) + tilex;
 
     uint16_t tileIndex = _GB_tileindexWithOffset(device, bgPixelOffset, true);
     uint32_t column = pixelX % 8;
     uint32_t row  = pixelY % 8;
-    GB_tile_pixel_value value = device->ppu->tiles[tileIndex][row][column];
-    device->ppu->frameBuffer[GBBackgroundFrameBuffer][frameIndex] = value;
+    GB_tile_pixel_value value = device->ppu.tiles[tileIndex][row][column];
+    device->ppu.frameBuffer[GBBackgroundFrameBuffer][frameIndex] = value;
 }
 
 void GB_updateObjectPixel(GB_device* device, Byte line, Byte xScan) {
     uint32_t frameIndex = ((uint32_t)line * 160) + xScan;
-    if (device->ppu->objEnable == false) {
+    if (device->ppu.objEnable == false) {
         // obj disabled set pixel to transparent
-        device->ppu->frameBuffer[GBObjectFrameBuffer][frameIndex] = GB_Tile_pixel_0;
+        device->ppu.frameBuffer[GBObjectFrameBuffer][frameIndex] = GB_Tile_pixel_0;
         return;
     }
 
-    Byte objHeight = device->ppu->objSize == GB_tile_bit_value_0 ? 8 : 16;
+    Byte objHeight = device->ppu.objSize == GB_tile_bit_value_0 ? 8 : 16;
     
     for (int index = 0; index < 0xA0; index += 4) {
-        Byte yPos = device->ppu->oam[index] - 16;
-        Byte xPos = device->ppu->oam[index + 1] - 8;
+        Byte yPos = device->ppu.oam[index] - 16;
+        Byte xPos = device->ppu.oam[index + 1] - 8;
 
         Byte yBottom = yPos + objHeight;
         Byte xRight = xPos + 8;
@@ -500,12 +509,12 @@ void GB_updateObjectPixel(GB_device* device, Byte line, Byte xScan) {
             // object outside vertical draw area
             continue;
         }
-        Byte tileIndex = device->ppu->oam[index + 2];
-        Byte attributes = device->ppu->oam[index + 3];
+        Byte tileIndex = device->ppu.oam[index + 2];
+        Byte attributes = device->ppu.oam[index + 3];
 
 
         Byte realTileIdx = tileIndex;
-        if (device->ppu->objSize == GB_tile_bit_value_0) {
+        if (device->ppu.objSize == GB_tile_bit_value_0) {
             realTileIdx = ((line - yPos) > 8) ? tileIndex | 0x01 : tileIndex & 0xFE;
         }
 
@@ -518,11 +527,11 @@ void GB_updateObjectPixel(GB_device* device, Byte line, Byte xScan) {
         if (attributes & 0x40) { // flip y
             row = 7 - row;
         }
-        GB_tile_pixel_value color = device->ppu->tiles[tileIndex][row][column];
+        GB_tile_pixel_value color = device->ppu.tiles[tileIndex][row][column];
 
         if (color != GB_Tile_pixel_0) {
-            device->ppu->objPriorities[frameIndex] = (attributes & 0x80) ? false : true;
-            device->ppu->frameBuffer[GBObjectFrameBuffer][frameIndex] = color;
+            device->ppu.objPriorities[frameIndex] = (attributes & 0x80) ? false : true;
+            device->ppu.frameBuffer[GBObjectFrameBuffer][frameIndex] = color;
             break;
         }
     }
@@ -531,7 +540,7 @@ void GB_updateObjectPixel(GB_device* device, Byte line, Byte xScan) {
 void GB_RenderProcessFrame(GB_device* device, Byte cycles) {
     // Between 172 and 289 dots
     // TODO: Handle draw penalities
-    GB_ppu* ppu = device->ppu;
+    GB_ppu* ppu = &device->ppu;
     if(ppu->clock >= 172) {
         ppu->clock = -CLOCK_INC;
         ppu->lineMode = GB_PPU_MODE_HBLANK;
@@ -541,7 +550,7 @@ void GB_RenderProcessFrame(GB_device* device, Byte cycles) {
         // printf("finished rendering line %d\n", ppu->line);
         // TODO: Line can be rendered here.
     }
-    if(ppu->clock < 160) {
+    if(ppu->clock < 160 && device->ppuSkipPixels == false) {
         int fetchToPerform = cycles;
         for (int i = 0; i < fetchToPerform; i++) {
             int scanX = ppu->clock + i;
@@ -560,12 +569,12 @@ uint16_t _GB_backgroundTileindexWithOffset(GB_device* device, Word offset) {
 uint16_t _GB_tileindexWithOffset(GB_device* device, Word offset, bool isWindow) {
     Word startAddr;
     if(isWindow == false) {
-        startAddr = (device->ppu->bgTileArea == GB_tile_bit_value_0) ? 0x9800 : 0x9C00;
+        startAddr = (device->ppu.bgTileArea == GB_tile_bit_value_0) ? 0x9800 : 0x9C00;
     } else {
-        startAddr = (device->ppu->bgTileArea == GB_tile_bit_value_0) ? 0x9C00 : 0x9800;
+        startAddr = (device->ppu.bgTileArea == GB_tile_bit_value_0) ? 0x9C00 : 0x9800;
     }
 
-    if (device->ppu->bgWinTileArea == GB_tile_bit_value_0) {
+    if (device->ppu.bgWinTileArea == GB_tile_bit_value_0) {
         uint8_t tileIdxData = GB_deviceReadByte(device, startAddr + offset);
         if (tileIdxData >= 128) {
             return tileIdxData;
@@ -576,7 +585,7 @@ uint16_t _GB_tileindexWithOffset(GB_device* device, Word offset, bool isWindow)
 }
 
 uint8_t* GB_ppu_gen_frame_bitmap(GB_device* device) {
-    GB_ppu* ppu = device->ppu;
+    GB_ppu* ppu = &device->ppu;
     int width = 160; // 32 * 8. 32 tiles of 8 pixels
     int height = 144;
     uint32_t size = width * height * 4; //for 32-bit bitmap only
@@ -590,9 +599,9 @@ uint8_t* GB_ppu_gen_frame_bitmap(GB_device* device) {
 
         uint32_t color;
         if (objColorId != GB_Tile_pixel_0 && (objPriority ||  bgColorId == GB_Tile_pixel_0)) {
-            color = GB_ppu_getObjPaletteColor(device->ppu, objColorId);
+            color = GB_ppu_getObjPaletteColor(&device->ppu, objColorId);
         } else {
-            color = GB_ppu_getBackgroundPaletteColor(device->ppu, bgColorId);
+            color = GB_ppu_getBackgroundPaletteColor(&device->ppu, bgColorId);
         }
         int p = i * 4;
         pixels[p + 0] = (color >> 8) & 0xFF; //blue
@@ -624,8 +633,8 @@ uint8_t* GB_ppu_gen_background_bitmap(GB_device* device) {
 
         for(int row = 0; row < tileHeight; row++) {
             for(int column = 0; column < tileWidth; column++) {            
-                GB_tile_pixel_value value = device->ppu->tiles[tileIndex][row][column];
-                unsigned int color = GB_ppu_getBackgroundPaletteColor(device->ppu, value);
+                GB_tile_pixel_value value = device->ppu.tiles[tileIndex][row][column];
+                unsigned int color = GB_ppu_getBackgroundPaletteColor(&device->ppu, value);
                 //color = 0x000000FF;
 
                 int p = startBGx + (column * 4) + (row * bgWidth) + startBGy;
@@ -658,8 +667,8 @@ void GB_ppu_gen_tile_bitmap(GB_ppu* ppu, int tileIndex) {
 
     unsigned char* pixels = GB_ppu_gen_tile_bitmap_data(ppu, tileIndex);
 
-    char *fileName;
-    asprintf(&fileName, "bit%d.bmp", tileIndex);
+    char fileName[32];
+    snprintf(fileName, sizeof(fileName), "bit%d.bmp", tileIndex);
     FILE *fout = fopen(fileName, "wb");
     fwrite(header, 1, 54, fout);
     fwrite(pixels, 1, size, fout);
@@ -1,7 +1,6 @@
 #include "definitions.h"
 #include <stdbool.h>
 #include <stdint.h>
-#include <sys/_types/_u_int32_t.h>
 
 #pragma once
 
@@ -43,7 +42,7 @@ typedef enum {
 GBNonCBGColors GBNonCBGColors_value_from_int(int);
 
 struct GB_ppu_s {
-    u_int32_t clock;
+    uint32_t clock;
     GB_ppu_mode lineMode;
     // LY: current line being handled
     Byte line;
@@ -97,6 +96,8 @@ Byte GB_deviceVramRead(GB_device* device, Word addr);
 void GB_deviceVramWrite(GB_device* device, Word addr, Byte data);
 void GB_devicePPUIOWrite(GB_device* device, Word addr, Byte data);
 Byte GB_devicePPUIORead(GB_device* device, Word addr);
+// Decodes `tiles` again from VRAM, e.g. after VRAM was restored from a save state
+void GB_ppuRebuildTiles(GB_device* device);
 
 // TODO: just for tests. remove later
 void GB_ppu_gen_tile_bitmap(GB_ppu* ppu, int tileIndex);
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "definitions.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Per-subsystem time accounting for the benchmark build.
+// Only compiled in with -DGB_PROFILE (the `bench-profile` target), every
+// other build, `bench` included, sees empty macros and pays nothing. Sections nest (memory accesses
+// happen inside CPU dispatch, the PPU is stepped from inside an
+// instruction) and time is charged to the innermost one only, so the
+// section totals add up to the time spent emulating.
+// Counters are raw timestamp ticks, callers turn them into shares of a
+// wall clock measurement rather than calibrating the tick rate.
+
+typedef enum {
+    // emulation loop and anything outside a section
+    GBProfileOther,
+    GBProfileCPU,
+    GBProfileMemory,
+    GBProfileTimer,
+    GBProfilePPU,
+    GBProfileAPU,
+    GBProfileSectionCount
+} GBProfileSection;
+
+#define GB_PROFILE_MAX_DEPTH 8
+
+struct GBProfile_s {
+    bool enabled;
+    uint8_t depth;
+    uint8_t stack[GB_PROFILE_MAX_DEPTH];
+    uint64_t last;
+    uint64_t ticks[GBProfileSectionCount];
+};
+
+#ifdef GB_PROFILE
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif !defined(__aarch64__)
+#include <time.h>
+#endif
+
+static inline uint64_t GBProfileTimestamp(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+#endif
+}
+
+static inline void GBProfileEnter(GBProfile* profile, GBProfileSection section) {
+    if (profile->enabled == false) {
+        return;
+    }
+    uint64_t now = GBProfileTimestamp();
+    profile->ticks[profile->stack[profile->depth]] += now - profile->last;
+    profile->last = now;
+    if (profile->depth + 1 < GB_PROFILE_MAX_DEPTH) {
+        profile->depth++;
+    }
+    profile->stack[profile->depth] = section;
+}
+
+static inline void GBProfileLeave(GBProfile* profile) {
+    if (profile->enabled == false) {
+        return;
+    }
+    uint64_t now = GBProfileTimestamp();
+    profile->ticks[profile->stack[profile->depth]] += now - profile->last;
+    profile->last = now;
+    if (profile->depth > 0) {
+        profile->depth--;
+    }
+}
+
+// Clears the counters and starts charging time to GBProfileOther
+static inline void GBProfileStart(GBProfile* profile) {
+    *profile = (GBProfile){ .enabled = true };
+    profile->last = GBProfileTimestamp();
+}
+
+// Charges the time since the last mark and stops counting
+static inline void GBProfileStop(GBProfile* profile) {
+    if (profile->enabled == false) {
+        return;
+    }
+    profile->ticks[profile->stack[profile->depth]] += GBProfileTimestamp() - profile->last;
+    profile->enabled = false;
+}
+
+#define GB_PROFILE_ENTER(device, section) GBProfileEnter(&(device)->profile, section)
+#define GB_PROFILE_LEAVE(device) GBProfileLeave(&(device)->profile)
+
+#else
+
+#define GB_PROFILE_ENTER(device, section) ((void)0)
+#define GB_PROFILE_LEAVE(device) ((void)0)
+
+#endif
@@ -0,0 +1,320 @@
+#include "Rewind.h"
+#include "SaveState.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Encoded size of an idle frame's delta: the clocks, timers and PPU
+// position still move, which takes a few runs of literals
+#define GB_REWIND_MIN_ENTRY_SIZE 32
+
+// MARK: Zero-run codec
+// The stream is a list of (zero run, literal run, literals), both runs as
+// LEB128 varints. Keyframes are encoded against an all-zero base.
+
+Byte* _GBRewindPutVarint(Byte* out, size_t value) {
+    while (value >= 0x80) {
+        *out++ = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    *out++ = (Byte)value;
+    return out;
+}
+
+const Byte* _GBRewindGetVarint(const Byte* in, const Byte* end, size_t* value) {
+    size_t result = 0;
+    int shift = 0;
+    while (in < end && shift < 64) {
+        Byte byte = *in++;
+        result |= (size_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return in;
+        }
+        shift += 7;
+    }
+    return NULL;
+}
+
+size_t GBRewindEncodeBound(size_t size) {
+    // a literal run costs at most 2 varints per 1 byte in the worst alternation
+    return size * 2 + 32;
+}
+
+// Encodes `state ^ base` (base may be NULL) and returns the encoded size
+size_t GBRewindEncode(const Byte* state, const Byte* base, size_t size, Byte* out) {
+    Byte* start = out;
+    size_t i = 0;
+    while (i < size) {
+        size_t zeros = i;
+        if (base != NULL) {
+            // skip identical words first, the bulk of a delta
+            while (zeros + sizeof(uint64_t) <= size) {
+                uint64_t a, b;
+                memcpy(&a, state + zeros, sizeof(a));
+                memcpy(&b, base + zeros, sizeof(b));
+                if (a != b) {
+                    break;
+                }
+                zeros += sizeof(uint64_t);
+            }
+            while (zeros < size && state[zeros] == base[zeros]) {
+                zeros++;
+            }
+        } else {
+            while (zeros < size && state[zeros] == 0) {
+                zeros++;
+            }
+        }
+
+        // literals end at the next run of at least 4 zero bytes (or the end)
+        size_t literals = zeros;
+        size_t zeroRun = 0;
+        while (literals + zeroRun < size && zeroRun < 4) {
+            Byte value = base != NULL ? state[literals + zeroRun] ^ base[literals + zeroRun] : state[literals + zeroRun];
+            if (value == 0) {
+                zeroRun++;
+            } else {
+                literals += zeroRun + 1;
+                zeroRun = 0;
+            }
+        }
+
+        out = _GBRewindPutVarint(out, zeros - i);
+        out = _GBRewindPutVarint(out, literals - zeros);
+        for (size_t j = zeros; j < literals; j++) {
+            *out++ = base != NULL ? state[j] ^ base[j] : state[j];
+        }
+        i = literals;
+    }
+    return out - start;
+}
+
+// Applies an encoded entry to `state`: XOR for deltas, overwrite for keyframes
+bool GBRewindDecode(const Byte* in, size_t inSize, Byte* state, size_t size, bool isKeyframe) {
+    const Byte* end = in + inSize;
+    size_t position = 0;
+    while (in < end) {
+        size_t zeros, literals;
+        in = _GBRewindGetVarint(in, end, &zeros);
+        if (in == NULL) {
+            return false;
+        }
+        in = _GBRewindGetVarint(in, end, &literals);
+        if (in == NULL || zeros > size - position || literals > size - position - zeros || literals > (size_t)(end - in)) {
+            return false;
+        }
+        if (isKeyframe) {
+            memset(state + position, 0, zeros);
+        }
+        position += zeros;
+        if (isKeyframe) {
+            memcpy(state + position, in, literals);
+        } else {
+            for (size_t j = 0; j < literals; j++) {
+                state[position + j] ^= in[j];
+            }
+        }
+        position += literals;
+        in += literals;
+    }
+    return position == size;
+}
+
+// MARK: History
+
+GBRewindEntry* _GBRewindEntry(GBRewindBuffer* rewind, uint32_t index) {
+    return &rewind->entries[(rewind->firstEntry + index) % rewind->entryCapacity];
+}
+
+// Drops the oldest keyframe and every delta depending on it
+void _GBRewindDropOldestGroup(GBRewindBuffer* rewind) {
+    do {
+        rewind->firstEntry = (rewind->firstEntry + 1) % rewind->entryCapacity;
+        rewind->entryCount--;
+    } while (rewind->entryCount > 0 && _GBRewindEntry(rewind, 0)->isKeyframe == false);
+}
+
+// Finds room for `size` contiguous bytes after the newest entry
+bool _GBRewindReserve(GBRewindBuffer* rewind, size_t size, size_t* offset) {
+    if (size > rewind->arenaSize) {
+        return false;
+    }
+    while (true) {
+        if (rewind->entryCount == 0) {
+            *offset = 0;
+            return true;
+        }
+        if (rewind->entryCount < rewind->entryCapacity) {
+            GBRewindEntry* oldest = _GBRewindEntry(rewind, 0);
+            GBRewindEntry* newest = _GBRewindEntry(rewind, rewind->entryCount - 1);
+            size_t end = newest->offset + newest->size;
+            if (newest->offset >= oldest->offset) {
+                // live bytes are [oldest, end): room after them or at the start
+                if (end + size <= rewind->arenaSize) {
+                    *offset = end;
+                    return true;
+                }
+                if (size <= oldest->offset) {
+                    *offset = 0;
+                    return true;
+                }
+            } else if (end + size <= oldest->offset) {
+                // wrapped: room between the newest and the oldest
+                *offset = end;
+                return true;
+            }
+        }
+        _GBRewindDropOldestGroup(rewind);
+    }
+}
+
+// Rebuilds the state of entry `index` into `state`
+bool _GBRewindReconstruct(GBRewindBuffer* rewind, uint32_t index, Byte* state) {
+    uint32_t key = index;
+    while (_GBRewindEntry(rewind, key)->isKeyframe == false) {
+        if (key == 0) {
+            return false; // keyframe evicted, cannot happen with group eviction
+        }
+        key--;
+    }
+    for (uint32_t i = key; i <= index; i++) {
+        GBRewindEntry* entry = _GBRewindEntry(rewind, i);
+        if (!GBRewindDecode(rewind->arena + entry->offset, entry->size, state, rewind->stateSize, entry->isKeyframe)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t _GBRewindDeltasSinceKeyframe(GBRewindBuffer* rewind) {
+    uint32_t count = 0;
+    for (uint32_t i = rewind->entryCount; i > 0; i--) {
+        if (_GBRewindEntry(rewind, i - 1)->isKeyframe) {
+            return count;
+        }
+        count++;
+    }
+    return UINT32_MAX;
+}
+
+GBRewindBuffer* GBRewindCreate(GB_device* device, size_t memoryBudget, uint32_t frameInterval, uint32_t keyframeInterval) {
+    GBRewindBuffer* rewind = malloc(sizeof(GBRewindBuffer));
+    if (rewind == NULL) {
+        return NULL;
+    }
+    memset(rewind, 0, sizeof(GBRewindBuffer));
+    rewind->device = device;
+    rewind->frameInterval = frameInterval == 0 ? 1 : frameInterval;
+    rewind->keyframeInterval = keyframeInterval == 0 ? 1 : keyframeInterval;
+    rewind->framesUntilCapture = 0;
+
+    rewind->stateSize = GB_saveStateSize(device);
+    // the entry table comes out of the budget, sized for arenas full of the
+    // smallest deltas; the arena gets the rest
+    size_t entryCost = GB_REWIND_MIN_ENTRY_SIZE + sizeof(GBRewindEntry);
+    if (memoryBudget / entryCost == 0) {
+        free(rewind);
+        return NULL;
+    }
+    rewind->entryCapacity = (uint32_t)(memoryBudget / entryCost);
+    rewind->arenaSize = memoryBudget - sizeof(GBRewindEntry) * rewind->entryCapacity;
+    rewind->arena = malloc(rewind->arenaSize);
+    rewind->entries = malloc(sizeof(GBRewindEntry) * rewind->entryCapacity);
+    rewind->previous = malloc(rewind->stateSize);
+    rewind->current = malloc(rewind->stateSize);
+    rewind->scratch = malloc(GBRewindEncodeBound(rewind->stateSize));
+    if (rewind->arena == NULL || rewind->entries == NULL || rewind->previous == NULL ||
+        rewind->current == NULL || rewind->scratch == NULL) {
+        GBRewindFree(rewind);
+        return NULL;
+    }
+    return rewind;
+}
+
+void GBRewindFree(GBRewindBuffer* rewind) {
+    if (rewind == NULL) {
+        return;
+    }
+    free(rewind->arena);
+    free(rewind->entries);
+    free(rewind->previous);
+    free(rewind->current);
+    free(rewind->scratch);
+    free(rewind);
+}
+
+void GBRewindClear(GBRewindBuffer* rewind) {
+    rewind->firstEntry = 0;
+    rewind->entryCount = 0;
+    rewind->framesUntilCapture = 0;
+}
+
+uint32_t GBRewindSnapshotCount(GBRewindBuffer* rewind) {
+    return rewind->entryCount;
+}
+
+void GBRewindOnFrame(GBRewindBuffer* rewind) {
+    if (rewind->framesUntilCapture > 0) {
+        rewind->framesUntilCapture--;
+        return;
+    }
+    rewind->framesUntilCapture = rewind->frameInterval - 1;
+    GBRewindCapture(rewind);
+}
+
+bool GBRewindCapture(GBRewindBuffer* rewind) {
+    if (GB_saveStateToBuffer(rewind->device, rewind->current, rewind->stateSize) != (long)rewind->stateSize) {
+        return false;
+    }
+
+    uint32_t deltas = _GBRewindDeltasSinceKeyframe(rewind);
+    bool isKeyframe = deltas == UINT32_MAX || deltas + 1 >= rewind->keyframeInterval;
+    size_t size = GBRewindEncode(rewind->current, isKeyframe ? NULL : rewind->previous, rewind->stateSize, rewind->scratch);
+
+    size_t offset;
+    if (!_GBRewindReserve(rewind, size, &offset)) {
+        return false;
+    }
+    if (rewind->entryCount == 0 && isKeyframe == false) {
+        // everything was evicted, the delta base is gone
+        isKeyframe = true;
+        size = GBRewindEncode(rewind->current, NULL, rewind->stateSize, rewind->scratch);
+        if (!_GBRewindReserve(rewind, size, &offset)) {
+            return false;
+        }
+    }
+    memcpy(rewind->arena + offset, rewind->scratch, size);
+    *_GBRewindEntry(rewind, rewind->entryCount) = (GBRewindEntry){offset, (uint32_t)size, isKeyframe};
+    rewind->entryCount++;
+
+    // the new snapshot is the base of the next delta
+    Byte* swap = rewind->previous;
+    rewind->previous = rewind->current;
+    rewind->current = swap;
+    return true;
+}
+
+bool GBRewindStepBack(GBRewindBuffer* rewind) {
+    if (rewind->entryCount == 0) {
+        return false;
+    }
+    uint32_t newest = rewind->entryCount - 1;
+    GBRewindEntry* entry = _GBRewindEntry(rewind, newest);
+
+    // rebuild the entry before the newest one, it becomes the next delta base
+    bool hasBase = newest > 0 && _GBRewindReconstruct(rewind, newest - 1, rewind->previous);
+    if (entry->isKeyframe || hasBase == false) {
+        if (!_GBRewindReconstruct(rewind, newest, rewind->current)) {
+            return false;
+        }
+    } else {
+        memcpy(rewind->current, rewind->previous, rewind->stateSize);
+        if (!GBRewindDecode(rewind->arena + entry->offset, entry->size, rewind->current, rewind->stateSize, false)) {
+            return false;
+        }
+    }
+
+    rewind->entryCount--;
+    rewind->framesUntilCapture = rewind->frameInterval - 1;
+    return GB_loadStateFromBuffer(rewind->device, rewind->current, rewind->stateSize) == GB_STATE_SUCCESS;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "definitions.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Rewind history.
+// Every `frameInterval` frames the device state is captured. Snapshots are
+// stored XORed against the previous one (a keyframe every `keyframeInterval`
+// snapshots is stored as is), then zero-run encoded: between two frames
+// almost all of WRAM/VRAM/OAM is unchanged, so a delta is mostly zeros.
+// Entries live in a fixed byte arena; when it is full the oldest keyframe
+// and its deltas are dropped together.
+// `memoryBudget` covers the arena and its entry table, the three raw state
+// buffers (about 3 x GB_saveStateSize) come on top. Returns NULL if the
+// budget cannot hold a single entry.
+
+struct GBRewindEntry_s {
+    size_t offset;
+    uint32_t size;
+    bool isKeyframe;
+};
+
+typedef struct GBRewindEntry_s GBRewindEntry;
+
+struct GBRewindBuffer_s {
+    GB_device* device;
+    uint32_t frameInterval;
+    uint32_t keyframeInterval;
+    uint32_t framesUntilCapture;
+
+    // encoded snapshots
+    Byte* arena;
+    size_t arenaSize;
+    GBRewindEntry* entries;   // circular, oldest at `firstEntry`
+    uint32_t entryCapacity;
+    uint32_t firstEntry;
+    uint32_t entryCount;
+
+    // raw state buffers, all `stateSize` bytes
+    size_t stateSize;
+    Byte* previous;   // state of the newest entry, base of the next delta
+    Byte* current;
+    Byte* scratch;    // encoder output, worst case size
+};
+
+GBRewindBuffer* GBRewindCreate(GB_device* device, size_t memoryBudget, uint32_t frameInterval, uint32_t keyframeInterval);
+void GBRewindFree(GBRewindBuffer* rewind);
+// Call once per emulated frame, captures every `frameInterval` frames
+void GBRewindOnFrame(GBRewindBuffer* rewind);
+bool GBRewindCapture(GBRewindBuffer* rewind);
+// Restores the newest snapshot and drops it from the history
+bool GBRewindStepBack(GBRewindBuffer* rewind);
+void GBRewindClear(GBRewindBuffer* rewind);
+uint32_t GBRewindSnapshotCount(GBRewindBuffer* rewind);
+
+// Zero-run codec of the snapshots, also used for movie keyframes.
+// `base` NULL encodes the state itself, decoding it needs `isKeyframe`.
+size_t GBRewindEncodeBound(size_t size);
+size_t GBRewindEncode(const Byte* state, const Byte* base, size_t size, Byte* out);
+bool GBRewindDecode(const Byte* in, size_t inSize, Byte* state, size_t size, bool isKeyframe);
@@ -0,0 +1,101 @@
+#include "RingBuffer.h"
+#include <stdlib.h>
+#include <string.h>
+
+GBRingBuffer* GBRingBufferCreate(uint32_t capacity, uint32_t elementSize) {
+    uint32_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    // header and storage in one cache-line aligned block
+    size_t headerSize = (sizeof(GBRingBuffer) + GB_CACHE_LINE_SIZE - 1) & ~(size_t)(GB_CACHE_LINE_SIZE - 1);
+    size_t totalSize = headerSize + (size_t)size * elementSize;
+    totalSize = (totalSize + GB_CACHE_LINE_SIZE - 1) & ~(size_t)(GB_CACHE_LINE_SIZE - 1);
+    GBRingBuffer* ring = aligned_alloc(GB_CACHE_LINE_SIZE, totalSize);
+    if (ring == NULL) {
+        return NULL;
+    }
+    memset(ring, 0, totalSize);
+
+    ring->capacity = size;
+    ring->elementSize = elementSize;
+    ring->data = (uint8_t*)ring + headerSize;
+    atomic_init(&ring->writeIndex, 0);
+    atomic_init(&ring->readIndex, 0);
+    return ring;
+}
+
+void GBRingBufferFree(GBRingBuffer* ring) {
+    free(ring);
+}
+
+void GBRingBufferReset(GBRingBuffer* ring) {
+    atomic_store_explicit(&ring->writeIndex, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->readIndex, 0, memory_order_relaxed);
+}
+
+uint32_t GBRingBufferWriteAvailable(GBRingBuffer* ring) {
+    uint32_t write = atomic_load_explicit(&ring->writeIndex, memory_order_relaxed);
+    uint32_t read = atomic_load_explicit(&ring->readIndex, memory_order_acquire);
+    return ring->capacity - (write - read);
+}
+
+uint32_t GBRingBufferWrite(GBRingBuffer* ring, const void* elements, uint32_t count) {
+    uint32_t write = atomic_load_explicit(&ring->writeIndex, memory_order_relaxed);
+    uint32_t read = atomic_load_explicit(&ring->readIndex, memory_order_acquire);
+    uint32_t space = ring->capacity - (write - read);
+    if (count > space) {
+        count = space;
+    }
+
+    uint32_t start = write & (ring->capacity - 1);
+    uint32_t part = ring->capacity - start;
+    if (part > count) {
+        part = count;
+    }
+    memcpy(ring->data + (size_t)start * ring->elementSize, elements, (size_t)part * ring->elementSize);
+    memcpy(ring->data, (const uint8_t*)elements + (size_t)part * ring->elementSize, (size_t)(count - part) * ring->elementSize);
+
+    // publish the elements before the new index
+    atomic_store_explicit(&ring->writeIndex, write + count, memory_order_release);
+    return count;
+}
+
+uint32_t GBRingBufferReadAvailable(GBRingBuffer* ring) {
+    uint32_t read = atomic_load_explicit(&ring->readIndex, memory_order_relaxed);
+    uint32_t write = atomic_load_explicit(&ring->writeIndex, memory_order_acquire);
+    return write - read;
+}
+
+uint32_t GBRingBufferRead(GBRingBuffer* ring, void* elements, uint32_t count) {
+    uint32_t read = atomic_load_explicit(&ring->readIndex, memory_order_relaxed);
+    uint32_t write = atomic_load_explicit(&ring->writeIndex, memory_order_acquire);
+    uint32_t available = write - read;
+    if (count > available) {
+        count = available;
+    }
+
+    uint32_t start = read & (ring->capacity - 1);
+    uint32_t part = ring->capacity - start;
+    if (part > count) {
+        part = count;
+    }
+    memcpy(elements, ring->data + (size_t)start * ring->elementSize, (size_t)part * ring->elementSize);
+    memcpy((uint8_t*)elements + (size_t)part * ring->elementSize, ring->data, (size_t)(count - part) * ring->elementSize);
+
+    // release the slots only once they have been copied out
+    atomic_store_explicit(&ring->readIndex, read + count, memory_order_release);
+    return count;
+}
+
+uint32_t GBRingBufferSkip(GBRingBuffer* ring, uint32_t count) {
+    uint32_t read = atomic_load_explicit(&ring->readIndex, memory_order_relaxed);
+    uint32_t write = atomic_load_explicit(&ring->writeIndex, memory_order_acquire);
+    uint32_t available = write - read;
+    if (count > available) {
+        count = available;
+    }
+    atomic_store_explicit(&ring->readIndex, read + count, memory_order_release);
+    return count;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "definitions.h"
+#include <stdatomic.h>
+#include <stdint.h>
+
+// Wait-free single-producer/single-consumer ring buffer.
+// One thread writes, one (possibly real-time) thread reads; neither ever
+// blocks. Capacity is a power of two so indexes wrap with a mask, and the
+// two indexes live on separate cache lines to avoid false sharing.
+
+#define GB_CACHE_LINE_SIZE 64
+
+struct GBRingBuffer_s {
+    // written by the producer only
+    _Atomic uint32_t writeIndex;
+    char writePadding[GB_CACHE_LINE_SIZE - sizeof(uint32_t)];
+    // written by the consumer only
+    _Atomic uint32_t readIndex;
+    char readPadding[GB_CACHE_LINE_SIZE - sizeof(uint32_t)];
+
+    uint32_t capacity;
+    uint32_t elementSize;
+    uint8_t* data;
+};
+
+GBRingBuffer* GBRingBufferCreate(uint32_t capacity, uint32_t elementSize);
+void GBRingBufferFree(GBRingBuffer* ring);
+// Not thread safe: only call while neither side is running.
+void GBRingBufferReset(GBRingBuffer* ring);
+
+// Producer side
+uint32_t GBRingBufferWriteAvailable(GBRingBuffer* ring);
+uint32_t GBRingBufferWrite(GBRingBuffer* ring, const void* elements, uint32_t count);
+
+// Consumer side
+uint32_t GBRingBufferReadAvailable(GBRingBuffer* ring);
+uint32_t GBRingBufferRead(GBRingBuffer* ring, void* elements, uint32_t count);
+uint32_t GBRingBufferSkip(GBRingBuffer* ring, uint32_t count);
@@ -0,0 +1,227 @@
+#include "RunAhead.h"
+#include "Device.h"
+#include "APU.h"
+#include "PPU.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Starts `ahead` from the authoritative state
+void _GBRunAheadCopy(GB_device* ahead, GB_device* device) {
+    GB_copyDeviceState(ahead, device);
+    // the copied background was never drawn: pixels the displayed frame does
+    // not draw (background disabled) show as color 0 instead of stale data
+    memset(ahead->ppu.frameBuffer[GBBackgroundFrameBuffer], 0, sizeof(ahead->ppu.frameBuffer[GBBackgroundFrameBuffer]));
+}
+
+// Hidden frames, then the displayed one
+void _GBRunAheadRunFrames(GB_device* ahead, uint32_t frames) {
+    for (uint32_t i = 0; i < frames; i++) {
+        ahead->ppuSkipPixels = i + 1 < frames;
+        GB_runFrame(ahead);
+    }
+}
+
+GBRunAhead* GBRunAheadCreate(GB_device* device, uint32_t frames) {
+    GBRunAhead* runAhead = malloc(sizeof(GBRunAhead));
+    if (runAhead == NULL) {
+        return NULL;
+    }
+    runAhead->device = device;
+    runAhead->ahead = GB_cloneDevice(device);
+    if (runAhead->ahead == NULL) {
+        free(runAhead);
+        return NULL;
+    }
+    // speculative audio is never heard
+    GBApuSetAudioMode(runAhead->ahead, GBApuAudioModeHeadless);
+    GBRunAheadSetFrames(runAhead, frames);
+    return runAhead;
+}
+
+void GBRunAheadFree(GBRunAhead* runAhead) {
+    if (runAhead == NULL) {
+        return;
+    }
+    runAhead->device->ppuSkipPixels = false;
+    GB_freeDevice(runAhead->ahead);
+    free(runAhead);
+}
+
+void GBRunAheadSetFrames(GBRunAhead* runAhead, uint32_t frames) {
+    runAhead->frames = frames > GB_RUN_AHEAD_MAX_FRAMES ? GB_RUN_AHEAD_MAX_FRAMES : frames;
+}
+
+GB_device* GBRunAheadFrame(GBRunAhead* runAhead, GBJoypadState joypad) {
+    GB_device* device = runAhead->device;
+    GBUpdateJoypadState(device, joypad);
+    device->ppuSkipPixels = runAhead->frames > 0;
+    GB_runFrame(device);
+    if (runAhead->frames == 0) {
+        return device;
+    }
+
+    _GBRunAheadCopy(runAhead->ahead, device);
+    _GBRunAheadRunFrames(runAhead->ahead, runAhead->frames);
+    return runAhead->ahead;
+}
+
+// MARK: Two-core speculation
+
+bool _GBRunAheadSameInput(GBJoypadState a, GBJoypadState b) {
+    return a.aPressed == b.aPressed && a.bPressed == b.bPressed &&
+        a.startPressed == b.startPressed && a.selectPressed == b.selectPressed &&
+        a.upPressed == b.upPressed && a.downPressed == b.downPressed &&
+        a.leftPressed == b.leftPressed && a.rightPressed == b.rightPressed;
+}
+
+// GB_runFrame that gives up early once the speculation is cancelled
+bool _GBRunAheadSpeculateFrame(GBRunAheadWorker* worker, GB_device* device) {
+    while (device->ppu.frameReady == false) {
+        if (atomic_load_explicit(&worker->cancel, memory_order_relaxed)) {
+            return false;
+        }
+        GB_deviceCpuStep(device);
+    }
+    device->ppu.frameReady = false;
+    return true;
+}
+
+void* _GBRunAheadWorkerThread(void* context) {
+    GBRunAheadWorker* worker = context;
+    pthread_mutex_lock(&worker->lock);
+    while (true) {
+        while (worker->running == false && worker->quit == false) {
+            pthread_cond_wait(&worker->changed, &worker->lock);
+        }
+        if (worker->quit) {
+            break;
+        }
+        GB_device* ahead = worker->ahead[1 - worker->displayed];
+        GBJoypadState predicted = worker->predicted;
+        pthread_mutex_unlock(&worker->lock);
+
+        // the authoritative device's next frame, then the displayed ones
+        GBUpdateJoypadState(ahead, predicted);
+        for (uint32_t i = 0; i <= worker->frames; i++) {
+            ahead->ppuSkipPixels = i < worker->frames;
+            if (!_GBRunAheadSpeculateFrame(worker, ahead)) {
+                break;
+            }
+        }
+
+        pthread_mutex_lock(&worker->lock);
+        worker->running = false;
+        pthread_cond_broadcast(&worker->changed);
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return NULL;
+}
+
+void _GBRunAheadWorkerWait(GBRunAheadWorker* worker) {
+    pthread_mutex_lock(&worker->lock);
+    while (worker->running) {
+        pthread_cond_wait(&worker->changed, &worker->lock);
+    }
+    pthread_mutex_unlock(&worker->lock);
+}
+
+// Starts speculating from the current authoritative state
+void _GBRunAheadWorkerPost(GBRunAheadWorker* worker, GBJoypadState joypad) {
+    _GBRunAheadCopy(worker->ahead[1 - worker->displayed], worker->device);
+
+    pthread_mutex_lock(&worker->lock);
+    worker->predicted = joypad;
+    atomic_store_explicit(&worker->cancel, false, memory_order_relaxed);
+    worker->running = true;
+    worker->hasSpeculation = true;
+    pthread_cond_broadcast(&worker->changed);
+    pthread_mutex_unlock(&worker->lock);
+}
+
+// Frees whichever speculation devices were created
+void _GBRunAheadWorkerFreeDevices(GBRunAheadWorker* worker) {
+    for (int i = 0; i < 2; i++) {
+        if (worker->ahead[i] != NULL) {
+            GB_freeDevice(worker->ahead[i]);
+            worker->ahead[i] = NULL;
+        }
+    }
+}
+
+GBRunAheadWorker* GBRunAheadWorkerCreate(GB_device* device, uint32_t frames) {
+    GBRunAheadWorker* worker = malloc(sizeof(GBRunAheadWorker));
+    if (worker == NULL) {
+        return NULL;
+    }
+    memset(worker, 0, sizeof(GBRunAheadWorker));
+    worker->device = device;
+    worker->frames = frames == 0 ? 1 : (frames > GB_RUN_AHEAD_MAX_FRAMES ? GB_RUN_AHEAD_MAX_FRAMES : frames);
+    for (int i = 0; i < 2; i++) {
+        worker->ahead[i] = GB_cloneDevice(device);
+        if (worker->ahead[i] == NULL) {
+            _GBRunAheadWorkerFreeDevices(worker);
+            free(worker);
+            return NULL;
+        }
+        GBApuSetAudioMode(worker->ahead[i], GBApuAudioModeHeadless);
+    }
+    atomic_init(&worker->cancel, false);
+    pthread_mutex_init(&worker->lock, NULL);
+    pthread_cond_init(&worker->changed, NULL);
+    if (pthread_create(&worker->thread, NULL, _GBRunAheadWorkerThread, worker) != 0) {
+        pthread_cond_destroy(&worker->changed);
+        pthread_mutex_destroy(&worker->lock);
+        _GBRunAheadWorkerFreeDevices(worker);
+        free(worker);
+        return NULL;
+    }
+    return worker;
+}
+
+void GBRunAheadWorkerFree(GBRunAheadWorker* worker) {
+    if (worker == NULL) {
+        return;
+    }
+    atomic_store_explicit(&worker->cancel, true, memory_order_relaxed);
+    pthread_mutex_lock(&worker->lock);
+    worker->quit = true;
+    pthread_cond_broadcast(&worker->changed);
+    pthread_mutex_unlock(&worker->lock);
+    pthread_join(worker->thread, NULL);
+
+    pthread_cond_destroy(&worker->changed);
+    pthread_mutex_destroy(&worker->lock);
+    worker->device->ppuSkipPixels = false;
+    _GBRunAheadWorkerFreeDevices(worker);
+    free(worker);
+}
+
+GB_device* GBRunAheadWorkerFrame(GBRunAheadWorker* worker, GBJoypadState joypad) {
+    GB_device* device = worker->device;
+    bool hit = worker->hasSpeculation && _GBRunAheadSameInput(joypad, worker->predicted);
+    if (worker->hasSpeculation && hit == false) {
+        atomic_store_explicit(&worker->cancel, true, memory_order_relaxed);
+    }
+
+    // the authoritative frame runs while the worker finishes its speculation
+    GBUpdateJoypadState(device, joypad);
+    device->ppuSkipPixels = true;
+    GB_runFrame(device);
+    _GBRunAheadWorkerWait(worker);
+
+    if (hit) {
+        worker->hits++;
+    } else {
+        if (worker->hasSpeculation) {
+            worker->misses++;
+        }
+        // single-core path into the non-displayed device
+        GB_device* ahead = worker->ahead[1 - worker->displayed];
+        _GBRunAheadCopy(ahead, device);
+        _GBRunAheadRunFrames(ahead, worker->frames);
+    }
+    worker->displayed = 1 - worker->displayed;
+
+    _GBRunAheadWorkerPost(worker, joypad);
+    return worker->ahead[worker->displayed];
+}
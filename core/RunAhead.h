@@ -0,0 +1,73 @@
+#pragma once
+
+#include "definitions.h"
+#include "MMU.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Run-ahead.
+// Most games read the joypad during one frame and only show the result one
+// or two frames later. Each host frame the authoritative device runs one
+// frame with the new input (audio on, no pixels), is copied into a second
+// device (GB_copyDeviceState, a single memcpy) and that copy runs `frames`
+// more frames headless, drawing pixels only in the last one. The copy is
+// what gets displayed, so the lag disappears at the cost of `frames` extra
+// frames of CPU time, without ever rolling the authoritative device back.
+
+#define GB_RUN_AHEAD_MAX_FRAMES 4
+
+struct GBRunAhead_s {
+    // runs the real timeline and produces the audio
+    GB_device* device;
+    // speculative copy, holds the displayed frame
+    GB_device* ahead;
+    uint32_t frames;
+};
+
+GBRunAhead* GBRunAheadCreate(GB_device* device, uint32_t frames);
+void GBRunAheadFree(GBRunAhead* runAhead);
+// 0 disables run-ahead, clamped to GB_RUN_AHEAD_MAX_FRAMES
+void GBRunAheadSetFrames(GBRunAhead* runAhead, uint32_t frames);
+// Runs one host frame with `joypad`, returns the device holding the frame
+// to display
+GB_device* GBRunAheadFrame(GBRunAhead* runAhead, GBJoypadState joypad);
+
+// Two-core variant.
+// After each host frame a worker thread copies the authoritative state and
+// speculates that the input will not change: it runs the next frame with
+// the same input, then the `frames` displayed ahead. When the next input
+// matches, the host thread only runs the authoritative frame (in parallel)
+// and shows the speculation. When it differs the speculation is cancelled
+// and that host frame falls back to the single-core path.
+
+struct GBRunAheadWorker_s {
+    // authoritative device, only touched by the host thread
+    GB_device* device;
+    // speculation target and displayed frame, swapped when a speculation is used
+    GB_device* ahead[2];
+    uint32_t displayed;
+    uint32_t frames;
+
+    pthread_t thread;
+    pthread_mutex_t lock;
+    // signaled when a speculation is posted, finished, or the worker quits
+    pthread_cond_t changed;
+    bool running;        // a speculation is posted and not finished
+    bool quit;
+    _Atomic bool cancel;
+    bool hasSpeculation; // the non-displayed device holds a finished or running speculation
+    GBJoypadState predicted;
+
+    // speculations used and discarded
+    uint64_t hits;
+    uint64_t misses;
+};
+
+// `frames` between 1 and GB_RUN_AHEAD_MAX_FRAMES
+GBRunAheadWorker* GBRunAheadWorkerCreate(GB_device* device, uint32_t frames);
+void GBRunAheadWorkerFree(GBRunAheadWorker* worker);
+// Same contract as GBRunAheadFrame. The returned device stays valid until
+// the next call.
+GB_device* GBRunAheadWorkerFrame(GBRunAheadWorker* worker, GBJoypadState joypad);
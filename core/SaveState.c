@@ -0,0 +1,589 @@
+#include "SaveState.h"
+#include "Device.h"
+#include "CPU.h"
+#include "MMU.h"
+#include "PPU.h"
+#include "APU.h"
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define GB_STATE_HEADER_SIZE  12
+#define GB_STATE_SECTION_HEADER_SIZE 8
+
+#define GB_STATE_TAG_ROM "ROM "
+#define GB_STATE_TAG_CPU "CPU "
+#define GB_STATE_TAG_MMU "MMU "
+#define GB_STATE_TAG_PPU "PPU "
+#define GB_STATE_TAG_APU "APU "
+
+// version 1 stored the serial port bit by bit: three u32 and a u8 where
+// version 2 has the u32 cycles left
+#define GB_STATE_V1_SERIAL_SIZE 13
+
+// MARK: Writer
+// With a NULL buffer the writer only counts, which gives the state size.
+
+typedef struct {
+    Byte* data;
+    size_t size;
+    size_t capacity;
+    size_t sectionStart;
+} GBStateWriter;
+
+void _GBStatePutBytes(GBStateWriter* writer, const void* bytes, size_t count) {
+    if (writer->data != NULL && writer->size + count <= writer->capacity) {
+        memcpy(writer->data + writer->size, bytes, count);
+    }
+    writer->size += count;
+}
+
+void _GBStatePut8(GBStateWriter* writer, Byte value) {
+    _GBStatePutBytes(writer, &value, 1);
+}
+
+void _GBStatePut16(GBStateWriter* writer, uint16_t value) {
+    Byte bytes[2] = {value & 0xFF, value >> 8};
+    _GBStatePutBytes(writer, bytes, 2);
+}
+
+void _GBStatePut32(GBStateWriter* writer, uint32_t value) {
+    Byte bytes[4] = {value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, value >> 24};
+    _GBStatePutBytes(writer, bytes, 4);
+}
+
+void _GBStatePut64(GBStateWriter* writer, uint64_t value) {
+    _GBStatePut32(writer, value & 0xFFFFFFFF);
+    _GBStatePut32(writer, value >> 32);
+}
+
+void _GBStateBeginSection(GBStateWriter* writer, const char* tag) {
+    _GBStatePutBytes(writer, tag, 4);
+    writer->sectionStart = writer->size;
+    _GBStatePut32(writer, 0); // patched by _GBStateEndSection
+}
+
+void _GBStateEndSection(GBStateWriter* writer) {
+    uint32_t size = (uint32_t)(writer->size - writer->sectionStart - 4);
+    if (writer->data != NULL && writer->size <= writer->capacity) {
+        Byte* out = writer->data + writer->sectionStart;
+        out[0] = size & 0xFF;
+        out[1] = (size >> 8) & 0xFF;
+        out[2] = (size >> 16) & 0xFF;
+        out[3] = size >> 24;
+    }
+}
+
+// MARK: Reader
+// Reads past the end of a section yield zeros and flag the state as invalid.
+
+typedef struct {
+    const Byte* data;
+    size_t size;
+    size_t position;
+    bool error;
+} GBStateReader;
+
+void _GBStateGetBytes(GBStateReader* reader, void* bytes, size_t count) {
+    if (reader->position + count > reader->size) {
+        reader->error = true;
+        memset(bytes, 0, count);
+        return;
+    }
+    memcpy(bytes, reader->data + reader->position, count);
+    reader->position += count;
+}
+
+Byte _GBStateGet8(GBStateReader* reader) {
+    Byte value;
+    _GBStateGetBytes(reader, &value, 1);
+    return value;
+}
+
+uint16_t _GBStateGet16(GBStateReader* reader) {
+    Byte bytes[2];
+    _GBStateGetBytes(reader, bytes, 2);
+    return bytes[0] | (bytes[1] << 8);
+}
+
+uint32_t _GBStateGet32(GBStateReader* reader) {
+    Byte bytes[4];
+    _GBStateGetBytes(reader, bytes, 4);
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+uint64_t _GBStateGet64(GBStateReader* reader) {
+    uint64_t low = _GBStateGet32(reader);
+    return low | ((uint64_t)_GBStateGet32(reader) << 32);
+}
+
+// MARK: Sections
+
+void _GBStateWriteCPU(GBStateWriter* w, GB_cpu* cpu) {
+    _GBStateBeginSection(w, GB_STATE_TAG_CPU);
+    GB_registers* r = &cpu->registers;
+    Byte registers[8] = {r->a, r->b, r->c, r->d, r->e, r->f, r->h, r->l};
+    _GBStatePutBytes(w, registers, 8);
+    _GBStatePut16(w, r->pc);
+    _GBStatePut16(w, r->sp);
+    _GBStatePut8(w, cpu->is_halted);
+    _GBStatePut8(w, cpu->IME);
+    _GBStatePut32(w, cpu->divCounter);
+    _GBStatePut8(w, cpu->enableINT);
+    _GBStatePut8(w, cpu->disableINT);
+    _GBStateEndSection(w);
+}
+
+void _GBStateReadCPU(GBStateReader* r, GB_cpu* cpu) {
+    GB_registers* regs = &cpu->registers;
+    regs->a = _GBStateGet8(r);
+    regs->b = _GBStateGet8(r);
+    regs->c = _GBStateGet8(r);
+    regs->d = _GBStateGet8(r);
+    regs->e = _GBStateGet8(r);
+    regs->f = _GBStateGet8(r);
+    regs->h = _GBStateGet8(r);
+    regs->l = _GBStateGet8(r);
+    regs->pc = _GBStateGet16(r);
+    regs->sp = _GBStateGet16(r);
+    cpu->is_halted = _GBStateGet8(r);
+    cpu->IME = _GBStateGet8(r);
+    cpu->divCounter = _GBStateGet32(r);
+    cpu->enableINT = _GBStateGet8(r);
+    cpu->disableINT = _GBStateGet8(r);
+}
+
+void _GBStateWriteMMU(GBStateWriter* w, GB_mmu* mmu) {
+    _GBStateBeginSection(w, GB_STATE_TAG_MMU);
+    _GBStatePut8(w, mmu->in_bios);
+    _GBStatePut16(w, mmu->romBank);
+    _GBStatePutBytes(w, mmu->eRam, sizeof(mmu->eRam));
+    _GBStatePutBytes(w, mmu->wRam, sizeof(mmu->wRam));
+    _GBStatePutBytes(w, mmu->zRam, sizeof(mmu->zRam));
+    _GBStatePut8(w, mmu->sb);
+    _GBStatePut8(w, mmu->sc);
+    _GBStatePut8(w, mmu->div);
+    _GBStatePut8(w, mmu->isTimaEnabled);
+    _GBStatePut8(w, mmu->timaClockCycles);
+    _GBStatePut8(w, mmu->tima);
+    _GBStatePut8(w, mmu->tma);
+    _GBStatePut8(w, mmu->tac);
+    _GBStatePut8(w, mmu->interruptEnable);
+    _GBStatePut8(w, mmu->interruptRequest);
+    _GBStatePut8(w, mmu->KEY1);
+    _GBStatePut8(w, mmu->timaStatus);
+    _GBStatePut32(w, mmu->timaCounter);
+    _GBStatePut8(w, mmu->joypadDpadSelected);
+    _GBStatePut8(w, mmu->joypadButtonSelected);
+    GBJoypadState* pad = &mmu->joypadState;
+    Byte buttons[8] = {
+        pad->aPressed, pad->bPressed, pad->selectPressed, pad->startPressed,
+        pad->rightPressed, pad->leftPressed, pad->upPressed, pad->downPressed
+    };
+    _GBStatePutBytes(w, buttons, 8);
+    // the event is stored relative to now, cycleCount itself is not state
+    uint32_t serialCycles = 0;
+    if (mmu->serialEventCycle != GB_SERIAL_IDLE) {
+        serialCycles = (uint32_t)(mmu->serialEventCycle - mmu->cycleCount);
+    }
+    _GBStatePut32(w, serialCycles);
+    _GBStateEndSection(w);
+}
+
+void _GBStateReadMMU(GBStateReader* r, GB_mmu* mmu, uint32_t version) {
+    mmu->in_bios = _GBStateGet8(r);
+    mmu->romBank = _GBStateGet16(r);
+    if (mmu->romBanking && (mmu->romBank == 0 || mmu->romBank >= mmu->romBankCount)) {
+        r->error = true;
+        mmu->romBank = 1;
+    }
+    _GBStateGetBytes(r, mmu->eRam, sizeof(mmu->eRam));
+    _GBStateGetBytes(r, mmu->wRam, sizeof(mmu->wRam));
+    _GBStateGetBytes(r, mmu->zRam, sizeof(mmu->zRam));
+    mmu->sb = _GBStateGet8(r);
+    mmu->sc = _GBStateGet8(r);
+    mmu->div = _GBStateGet8(r);
+    mmu->isTimaEnabled = _GBStateGet8(r);
+    mmu->timaClockCycles = _GBStateGet8(r) & 0x3;
+    mmu->tima = _GBStateGet8(r);
+    mmu->tma = _GBStateGet8(r);
+    mmu->tac = _GBStateGet8(r);
+    mmu->interruptEnable = _GBStateGet8(r);
+    mmu->interruptRequest = _GBStateGet8(r);
+    mmu->KEY1 = _GBStateGet8(r);
+    mmu->timaStatus = _GBStateGet8(r);
+    mmu->timaCounter = _GBStateGet32(r);
+    mmu->joypadDpadSelected = _GBStateGet8(r);
+    mmu->joypadButtonSelected = _GBStateGet8(r);
+    GBJoypadState* pad = &mmu->joypadState;
+    pad->aPressed = _GBStateGet8(r);
+    pad->bPressed = _GBStateGet8(r);
+    pad->selectPressed = _GBStateGet8(r);
+    pad->startPressed = _GBStateGet8(r);
+    pad->rightPressed = _GBStateGet8(r);
+    pad->leftPressed = _GBStateGet8(r);
+    pad->upPressed = _GBStateGet8(r);
+    pad->downPressed = _GBStateGet8(r);
+    uint32_t serialCycles;
+    if (version == 1) {
+        // bit-level countdown, period, bits left and incoming byte; a
+        // transfer in flight restarts from its first bit
+        _GBStateGet32(r);
+        _GBStateGet32(r);
+        _GBStateGet32(r);
+        _GBStateGet8(r);
+        serialCycles = (mmu->sc & 0x81) == 0x81 ? GB_SERIAL_TRANSFER_CYCLES : 0;
+    } else {
+        serialCycles = _GBStateGet32(r);
+    }
+    mmu->serialEventCycle = serialCycles != 0 ? mmu->cycleCount + serialCycles : GB_SERIAL_IDLE;
+}
+
+void _GBStateWritePPU(GBStateWriter* w, GB_ppu* ppu) {
+    _GBStateBeginSection(w, GB_STATE_TAG_PPU);
+    _GBStatePut32(w, ppu->clock);
+    _GBStatePut8(w, ppu->lineMode);
+    _GBStatePut8(w, ppu->line);
+    _GBStatePut8(w, ppu->lineCMP);
+    _GBStatePut8(w, ppu->scrollY);
+    _GBStatePut8(w, ppu->scrollX);
+    _GBStatePut8(w, ppu->windowY);
+    _GBStatePut8(w, ppu->windowX);
+    _GBStatePut8(w, ppu->vramBankIndex);
+    _GBStatePut8(w, ppu->isLYCInterruptEnabled);
+    _GBStatePut8(w, ppu->isMode0InterruptEnabled);
+    _GBStatePut8(w, ppu->isMode1InterruptEnabled);
+    _GBStatePut8(w, ppu->isMode2InterruptEnabled);
+    _GBStatePut8(w, ppu->frameReady);
+    _GBStatePut8(w, ppu->isLCDEnabled);
+    _GBStatePut8(w, ppu->windowTileMap);
+    _GBStatePut8(w, ppu->isWindowEnabled);
+    _GBStatePut8(w, ppu->bgWinTileArea);
+    _GBStatePut8(w, ppu->bgTileArea);
+    _GBStatePut8(w, ppu->objSize);
+    _GBStatePut8(w, ppu->objEnable);
+    _GBStatePut8(w, ppu->isBGWinEnabled);
+    _GBStatePut8(w, ppu->LcdPpuEnable);
+    _GBStatePut8(w, ppu->controlBit);
+    _GBStatePut8(w, ppu->dmaValue);
+    for (int i = 0; i < 4; i++) {
+        _GBStatePut8(w, ppu->bgpIdColors[i]);
+        _GBStatePut8(w, ppu->objp0IdColor[i]);
+        _GBStatePut8(w, ppu->objp1IdColor[i]);
+    }
+    _GBStatePutBytes(w, ppu->vRam, sizeof(ppu->vRam));
+    _GBStatePutBytes(w, ppu->oam, sizeof(ppu->oam));
+
+    // the frame being drawn, one byte per pixel (color index or priority)
+    Byte line[160];
+    for (int buffer = 0; buffer < 2; buffer++) {
+        for (int y = 0; y < 144; y++) {
+            for (int x = 0; x < 160; x++) {
+                line[x] = ppu->frameBuffer[buffer][y * 160 + x];
+            }
+            _GBStatePutBytes(w, line, 160);
+        }
+    }
+    for (int y = 0; y < 144; y++) {
+        for (int x = 0; x < 160; x++) {
+            line[x] = ppu->objPriorities[y * 160 + x];
+        }
+        _GBStatePutBytes(w, line, 160);
+    }
+    _GBStateEndSection(w);
+}
+
+void _GBStateReadPPU(GBStateReader* r, GB_ppu* ppu) {
+    ppu->clock = _GBStateGet32(r);
+    ppu->lineMode = _GBStateGet8(r) & 0x3;
+    ppu->line = _GBStateGet8(r);
+    ppu->lineCMP = _GBStateGet8(r);
+    ppu->scrollY = _GBStateGet8(r);
+    ppu->scrollX = _GBStateGet8(r);
+    ppu->windowY = _GBStateGet8(r);
+    ppu->windowX = _GBStateGet8(r);
+    ppu->vramBankIndex = _GBStateGet8(r);
+    ppu->isLYCInterruptEnabled = _GBStateGet8(r);
+    ppu->isMode0InterruptEnabled = _GBStateGet8(r);
+    ppu->isMode1InterruptEnabled = _GBStateGet8(r);
+    ppu->isMode2InterruptEnabled = _GBStateGet8(r);
+    ppu->frameReady = _GBStateGet8(r);
+    ppu->isLCDEnabled = _GBStateGet8(r);
+    ppu->windowTileMap = _GBStateGet8(r) & 0x1;
+    ppu->isWindowEnabled = _GBStateGet8(r);
+    ppu->bgWinTileArea = _GBStateGet8(r) & 0x1;
+    ppu->bgTileArea = _GBStateGet8(r) & 0x1;
+    ppu->objSize = _GBStateGet8(r) & 0x1;
+    ppu->objEnable = _GBStateGet8(r);
+    ppu->isBGWinEnabled = _GBStateGet8(r);
+    ppu->LcdPpuEnable = _GBStateGet8(r) & 0x1;
+    ppu->controlBit = _GBStateGet8(r);
+    ppu->dmaValue = _GBStateGet8(r);
+    for (int i = 0; i < 4; i++) {
+        ppu->bgpIdColors[i] = _GBStateGet8(r) & 0x3;
+        ppu->objp0IdColor[i] = _GBStateGet8(r) & 0x3;
+        ppu->objp1IdColor[i] = _GBStateGet8(r) & 0x3;
+    }
+    _GBStateGetBytes(r, ppu->vRam, sizeof(ppu->vRam));
+    _GBStateGetBytes(r, ppu->oam, sizeof(ppu->oam));
+
+    Byte line[160];
+    for (int buffer = 0; buffer < 2; buffer++) {
+        for (int y = 0; y < 144; y++) {
+            _GBStateGetBytes(r, line, 160);
+            for (int x = 0; x < 160; x++) {
+                ppu->frameBuffer[buffer][y * 160 + x] = line[x] & 0x3;
+            }
+        }
+    }
+    for (int y = 0; y < 144; y++) {
+        _GBStateGetBytes(r, line, 160);
+        for (int x = 0; x < 160; x++) {
+            ppu->objPriorities[y * 160 + x] = line[x] != 0;
+        }
+    }
+}
+
+void _GBStateWriteAPU(GBStateWriter* w, GBApu* apu) {
+    _GBStateBeginSection(w, GB_STATE_TAG_APU);
+    _GBStatePut32(w, apu->clock);
+    _GBStatePut64(w, apu->elapsedTicks);
+    // headless devices do not step the square/noise generators
+    _GBStatePut8(w, apu->audioMode == GBApuAudioModeHeadless);
+    _GBStatePut16(w, apu->periodOnTrigger);
+    _GBStatePut16(w, apu->lfsrState);
+    _GBStatePut32(w, apu->waveReadclock);
+    _GBStatePut8(w, apu->ch1SweepEnabled);
+    _GBStatePut8(w, apu->ch1StepZero);
+    _GBStatePut8(w, apu->ch1NegModeUsed);
+    _GBStatePut8(w, apu->divApu);
+    _GBStatePut8(w, apu->waveValue);
+    _GBStatePut8(w, apu->divBitUp);
+    _GBStatePut8(w, apu->periodSweepTimer);
+    for (int ch = 0; ch < GBSoundChannelCount; ch++) {
+        _GBStatePut16(w, apu->envelopeSweepTimer[ch]);
+        _GBStatePut8(w, apu->envelopeVolume[ch]);
+        _GBStatePut8(w, apu->activeChannels[ch]);
+        _GBStatePut32(w, apu->channelValues[ch]);
+        _GBStatePut8(w, apu->channelLen[ch]);
+        _GBStatePut8(w, apu->channelSweepPace[ch]);
+        _GBStatePut32(w, apu->channelNextEvent[ch]);
+        _GBStatePut8(w, apu->channelReaderCursors[ch]);
+    }
+    _GBStatePutBytes(w, apu->data, sizeof(apu->data));
+    _GBStateEndSection(w);
+}
+
+// Returns true when the generator timing has to be restarted
+bool _GBStateReadAPU(GBStateReader* r, GBApu* apu) {
+    apu->clock = _GBStateGet32(r);
+    apu->elapsedTicks = _GBStateGet64(r);
+    bool generatorsStale = _GBStateGet8(r);
+    apu->periodOnTrigger = _GBStateGet16(r);
+    apu->lfsrState = _GBStateGet16(r);
+    apu->waveReadclock = _GBStateGet32(r);
+    apu->ch1SweepEnabled = _GBStateGet8(r);
+    apu->ch1StepZero = _GBStateGet8(r);
+    apu->ch1NegModeUsed = _GBStateGet8(r);
+    apu->divApu = _GBStateGet8(r);
+    apu->waveValue = _GBStateGet8(r);
+    apu->divBitUp = _GBStateGet8(r);
+    apu->periodSweepTimer = _GBStateGet8(r);
+    for (int ch = 0; ch < GBSoundChannelCount; ch++) {
+        apu->envelopeSweepTimer[ch] = _GBStateGet16(r);
+        apu->envelopeVolume[ch] = _GBStateGet8(r);
+        apu->activeChannels[ch] = _GBStateGet8(r);
+        apu->channelValues[ch] = (int32_t)_GBStateGet32(r);
+        apu->channelLen[ch] = _GBStateGet8(r);
+        apu->channelSweepPace[ch] = _GBStateGet8(r);
+        apu->channelNextEvent[ch] = _GBStateGet32(r);
+        apu->channelReaderCursors[ch] = _GBStateGet8(r);
+    }
+    _GBStateGetBytes(r, apu->data, sizeof(apu->data));
+    return generatorsStale;
+}
+
+// MARK: State
+
+size_t _GBStateWrite(GB_device* device, GBStateWriter* writer) {
+    _GBStatePutBytes(writer, GB_STATE_MAGIC, 4);
+    _GBStatePut32(writer, GB_STATE_VERSION);
+    _GBStatePut32(writer, 5); // section count
+
+    _GBStateBeginSection(writer, GB_STATE_TAG_ROM);
+    _GBStatePut32(writer, device->mmu.romSize);
+    _GBStatePut64(writer, device->mmu.romHash);
+    _GBStateEndSection(writer);
+
+    _GBStateWriteCPU(writer, &device->cpu);
+    _GBStateWriteMMU(writer, &device->mmu);
+    _GBStateWritePPU(writer, &device->ppu);
+    _GBStateWriteAPU(writer, &device->apu);
+    return writer->size;
+}
+
+size_t GB_saveStateSize(GB_device* device) {
+    GBStateWriter writer = {NULL, 0, 0, 0};
+    return _GBStateWrite(device, &writer);
+}
+
+long GB_saveStateToBuffer(GB_device* device, void* buffer, size_t capacity) {
+    GBStateWriter writer = {buffer, 0, capacity, 0};
+    size_t size = _GBStateWrite(device, &writer);
+    if (size > capacity) {
+        return GB_STATE_BUFFER_SIZE;
+    }
+    return (long)size;
+}
+
+// Payload size each section reader consumes, measured with the counting
+// writer so it always matches what _GBStateWrite produces
+typedef struct {
+    size_t cpu;
+    size_t mmu;
+    size_t ppu;
+    size_t apu;
+} GBStateSectionSizes;
+
+size_t _GBStateMeasure(GBStateWriter* counter) {
+    size_t size = counter->size - GB_STATE_SECTION_HEADER_SIZE;
+    counter->size = 0;
+    return size;
+}
+
+GBStateSectionSizes _GBStateSectionSizes(GB_device* device, uint32_t version) {
+    GBStateWriter counter = {NULL, 0, 0, 0};
+    GBStateSectionSizes sizes;
+    _GBStateWriteCPU(&counter, &device->cpu);
+    sizes.cpu = _GBStateMeasure(&counter);
+    _GBStateWriteMMU(&counter, &device->mmu);
+    sizes.mmu = _GBStateMeasure(&counter);
+    if (version == 1) {
+        sizes.mmu += GB_STATE_V1_SERIAL_SIZE - sizeof(uint32_t);
+    }
+    _GBStateWritePPU(&counter, &device->ppu);
+    sizes.ppu = _GBStateMeasure(&counter);
+    _GBStateWriteAPU(&counter, &device->apu);
+    sizes.apu = _GBStateMeasure(&counter);
+    return sizes;
+}
+
+// Finds a section and returns a reader over its payload
+bool _GBStateFindSection(const Byte* data, size_t size, const char* tag, GBStateReader* section) {
+    size_t position = GB_STATE_HEADER_SIZE;
+    while (position + GB_STATE_SECTION_HEADER_SIZE <= size) {
+        const Byte* header = data + position;
+        size_t sectionSize = header[4] | (header[5] << 8) | (header[6] << 16) | ((size_t)header[7] << 24);
+        position += GB_STATE_SECTION_HEADER_SIZE;
+        if (sectionSize > size - position) {
+            return false;
+        }
+        if (memcmp(header, tag, 4) == 0) {
+            *section = (GBStateReader){data + position, sectionSize, 0, false};
+            return true;
+        }
+        position += sectionSize;
+    }
+    return false;
+}
+
+int GB_loadStateFromBuffer(GB_device* device, const void* buffer, size_t size) {
+    const Byte* data = buffer;
+    if (size < GB_STATE_HEADER_SIZE || memcmp(data, GB_STATE_MAGIC, 4) != 0) {
+        return GB_STATE_FORMAT_ERROR;
+    }
+    GBStateReader header = {data, size, 4, false};
+    uint32_t version = _GBStateGet32(&header);
+    if (version == 0 || version > GB_STATE_VERSION) {
+        return GB_STATE_FORMAT_ERROR;
+    }
+
+    // validate everything before touching the device
+    GBStateReader rom, cpu, mmu, ppu, apu;
+    if (!_GBStateFindSection(data, size, GB_STATE_TAG_ROM, &rom) ||
+        !_GBStateFindSection(data, size, GB_STATE_TAG_CPU, &cpu) ||
+        !_GBStateFindSection(data, size, GB_STATE_TAG_MMU, &mmu) ||
+        !_GBStateFindSection(data, size, GB_STATE_TAG_PPU, &ppu) ||
+        !_GBStateFindSection(data, size, GB_STATE_TAG_APU, &apu)) {
+        return GB_STATE_FORMAT_ERROR;
+    }
+    uint32_t romSize = _GBStateGet32(&rom);
+    uint64_t romHash = _GBStateGet64(&rom);
+    if (rom.error) {
+        return GB_STATE_FORMAT_ERROR;
+    }
+    if (romSize != device->mmu.romSize || romHash != device->mmu.romHash) {
+        return GB_STATE_ROM_MISMATCH;
+    }
+    // a short section would be read as zeros over the live device
+    GBStateSectionSizes sizes = _GBStateSectionSizes(device, version);
+    if (cpu.size < sizes.cpu || mmu.size < sizes.mmu || ppu.size < sizes.ppu || apu.size < sizes.apu) {
+        return GB_STATE_FORMAT_ERROR;
+    }
+    // the only value the readers reject, right after in_bios
+    uint16_t romBank = mmu.data[1] | (mmu.data[2] << 8);
+    if (device->mmu.romBanking && (romBank == 0 || romBank >= device->mmu.romBankCount)) {
+        return GB_STATE_FORMAT_ERROR;
+    }
+
+    _GBStateReadCPU(&cpu, &device->cpu);
+    _GBStateReadMMU(&mmu, &device->mmu, version);
+    _GBStateReadPPU(&ppu, &device->ppu);
+    bool generatorsStale = _GBStateReadAPU(&apu, &device->apu);
+
+    // derived state
+    GB_ppuRebuildTiles(device);
+    GBApuResyncOutput(device, generatorsStale);
+
+    if (cpu.error || mmu.error || ppu.error || apu.error) {
+        return GB_STATE_FORMAT_ERROR; // unreachable after the checks above
+    }
+    return GB_STATE_SUCCESS;
+}
+
+int GB_saveState(GB_device* device, const char* filePath) {
+    size_t size = GB_saveStateSize(device);
+    Byte* buffer = malloc(size);
+    if (buffer == NULL) {
+        return GB_STATE_FILE_ERROR;
+    }
+    GB_saveStateToBuffer(device, buffer, size);
+
+    FILE* file = fopen(filePath, "wb");
+    if (file == NULL) {
+        free(buffer);
+        return GB_STATE_FILE_ERROR;
+    }
+    size_t written = fwrite(buffer, 1, size, file);
+    free(buffer);
+    if (fclose(file) != 0 || written != size) {
+        return GB_STATE_FILE_ERROR;
+    }
+    return GB_STATE_SUCCESS;
+}
+
+int GB_loadState(GB_device* device, const char* filePath) {
+    int fd = open(filePath, O_RDONLY);
+    if (fd < 0) {
+        return GB_STATE_FILE_ERROR;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return GB_STATE_FILE_ERROR;
+    }
+    void* data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return GB_STATE_FILE_ERROR;
+    }
+
+    int result = GB_loadStateFromBuffer(device, data, info.st_size);
+    munmap(data, info.st_size);
+    return result;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "definitions.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Save states.
+// A state is a small header followed by tagged sections (CPU, MMU, PPU, APU,
+// ROM identity), each with its own size so unknown sections can be skipped.
+// All values are little-endian and written field by field, so states do not
+// depend on struct layout. Derivable data (decoded tiles, host audio output,
+// the ROM itself) is not stored: the ROM is identified by hash and must
+// already be loaded in the target device.
+
+#define GB_STATE_MAGIC   "NBST"
+#define GB_STATE_VERSION 2
+
+#define GB_STATE_SUCCESS       0
+#define GB_STATE_FILE_ERROR   -1
+#define GB_STATE_FORMAT_ERROR -2
+#define GB_STATE_ROM_MISMATCH -3
+#define GB_STATE_BUFFER_SIZE  -4
+
+// Exact number of bytes GB_saveStateToBuffer needs
+size_t GB_saveStateSize(GB_device* device);
+// Returns the number of bytes written, or GB_STATE_BUFFER_SIZE if `capacity` is too small
+long GB_saveStateToBuffer(GB_device* device, void* buffer, size_t capacity);
+// `data` can point straight into a mapped file, it is only read
+int GB_loadStateFromBuffer(GB_device* device, const void* data, size_t size);
+
+int GB_saveState(GB_device* device, const char* filePath);
+// Maps the file and loads it without an intermediate copy
+int GB_loadState(GB_device* device, const char* filePath);
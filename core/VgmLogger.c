@@ -0,0 +1,96 @@
+#include "VgmLogger.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define GB_VGM_CMD_GB_WRITE  0xB3
+#define GB_VGM_CMD_WAIT      0x61
+#define GB_VGM_CMD_WAIT_1    0x70 // 0x7n waits n + 1 samples
+#define GB_VGM_CMD_END       0x66
+#define GB_VGM_VERSION       0x171
+#define GB_VGM_DMG_CLOCK     4194304
+
+void _GBVgmHeader(Byte* header, uint32_t fileSize, uint32_t totalSamples) {
+    memset(header, 0, GB_VGM_HEADER_SIZE);
+    memcpy(header, "Vgm ", 4);
+    GBPutLE32(header + 0x04, fileSize - 0x04);
+    GBPutLE32(header + 0x08, GB_VGM_VERSION);
+    GBPutLE32(header + 0x18, totalSamples);
+    GBPutLE32(header + 0x34, GB_VGM_HEADER_SIZE - 0x34);
+    GBPutLE32(header + 0x80, GB_VGM_DMG_CLOCK);
+}
+
+// Emits wait commands until the stream reaches `tick`
+void _GBVgmWaitUntil(GBVgmLogger* logger, uint64_t tick) {
+    // computed from the absolute time so rounding never accumulates
+    uint64_t target = (tick - logger->startTick) * GB_VGM_SAMPLE_RATE / logger->clockRate;
+    while (logger->samplesWritten < target) {
+        uint64_t wait = target - logger->samplesWritten;
+        if (wait <= 16) {
+            Byte command = GB_VGM_CMD_WAIT_1 + (Byte)(wait - 1);
+            GBFileWriterWrite(&logger->writer, &command, 1);
+        } else {
+            if (wait > 0xFFFF) {
+                wait = 0xFFFF;
+            }
+            Byte command[3] = {GB_VGM_CMD_WAIT, wait & 0xFF, wait >> 8};
+            GBFileWriterWrite(&logger->writer, command, 3);
+        }
+        logger->samplesWritten += wait;
+    }
+}
+
+// Writer thread
+void _GBVgmWriteEvents(void* context, void* items, uint32_t count) {
+    GBVgmLogger* logger = context;
+    const GBVgmEvent* events = items;
+    for (uint32_t i = 0; i < count; i++) {
+        _GBVgmWaitUntil(logger, events[i].tick);
+        Byte command[3] = {GB_VGM_CMD_GB_WRITE, events[i].reg, events[i].value};
+        GBFileWriterWrite(&logger->writer, command, 3);
+    }
+}
+
+GBVgmLogger* GBVgmLoggerOpen(const char* path, uint32_t clockRate, uint64_t startTick) {
+    GBVgmLogger* logger = malloc(sizeof(GBVgmLogger));
+    if (logger == NULL) {
+        return NULL;
+    }
+    memset(logger, 0, sizeof(GBVgmLogger));
+    logger->clockRate = clockRate;
+    logger->startTick = startTick;
+
+    GBFileWriterFormat format = {
+        .name = "VGM",
+        .itemSize = sizeof(GBVgmEvent),
+        .ringItems = GB_VGM_RING_EVENTS,
+        .blockItems = GB_VGM_BLOCK_EVENTS,
+        .writeBlock = _GBVgmWriteEvents,
+    };
+    // placeholder, sizes are patched on close
+    Byte header[GB_VGM_HEADER_SIZE];
+    _GBVgmHeader(header, GB_VGM_HEADER_SIZE, 0);
+    if (!GBFileWriterOpen(&logger->writer, path, format, logger, header, GB_VGM_HEADER_SIZE)) {
+        free(logger);
+        return NULL;
+    }
+    return logger;
+}
+
+void GBVgmLoggerPush(GBVgmLogger* logger, uint64_t tick, Byte reg, Byte value) {
+    GBVgmEvent event = {tick, reg, value};
+    GBFileWriterPush(&logger->writer, &event, 1);
+}
+
+bool GBVgmLoggerClose(GBVgmLogger* logger, uint64_t endTick) {
+    GBFileWriterStop(&logger->writer);
+
+    _GBVgmWaitUntil(logger, endTick);
+    Byte end = GB_VGM_CMD_END;
+    GBFileWriterWrite(&logger->writer, &end, 1);
+
+    Byte header[GB_VGM_HEADER_SIZE];
+    _GBVgmHeader(header, (uint32_t)logger->writer.bytesWritten, (uint32_t)logger->samplesWritten);
+    bool success = GBFileWriterClose(&logger->writer, header, GB_VGM_HEADER_SIZE);
+    free(logger);
+    return success;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "definitions.h"
+#include "FileWriter.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Logs APU register writes as a VGM 1.71 stream (Game Boy DMG chip).
+// The emulation thread appends one timestamped event per write to a
+// GBFileWriter, whose thread turns them into VGM wait/write commands.
+// The result can be re-synthesized by any VGM player at any rate.
+
+#define GB_VGM_HEADER_SIZE   0x100
+#define GB_VGM_SAMPLE_RATE   44100
+#define GB_VGM_RING_EVENTS   0x10000
+#define GB_VGM_BLOCK_EVENTS  0x1000
+
+struct GBVgmEvent_s {
+    uint64_t tick;     // APU ticks since power on
+    Byte reg;           // offset from 0xFF10
+    Byte value;
+};
+
+typedef struct GBVgmEvent_s GBVgmEvent;
+
+struct GBVgmLogger_s {
+    GBFileWriter writer;
+    uint32_t clockRate;
+    // writer thread state
+    uint64_t startTick;
+    uint64_t samplesWritten;
+};
+
+// `clockRate` is the tick rate of the timestamps, `startTick` the time of the first event
+GBVgmLogger* GBVgmLoggerOpen(const char* path, uint32_t clockRate, uint64_t startTick);
+// Emulation thread, one buffered append per register write
+void GBVgmLoggerPush(GBVgmLogger* logger, uint64_t tick, Byte reg, Byte value);
+// Pads the stream up to `endTick`, finalizes the header and closes the file.
+// Returns false if any write failed.
+bool GBVgmLoggerClose(GBVgmLogger* logger, uint64_t endTick);
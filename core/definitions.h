@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdint.h>
+
 #define Byte unsigned char
 #define Word unsigned short
 
@@ -32,4 +34,34 @@ struct GBAPU_s;
 typedef struct GBAPU_s GBApu; 
 
 struct GBSample_s;
-typedef struct GBSample_s GBSample;
\ No newline at end of file
+typedef struct GBSample_s GBSample;
+
+struct GBRingBuffer_s;
+typedef struct GBRingBuffer_s GBRingBuffer;
+
+struct GBSPlayer_s;
+typedef struct GBSPlayer_s GBSPlayer;
+
+struct GBVgmLogger_s;
+typedef struct GBVgmLogger_s GBVgmLogger;
+
+struct GBRewindBuffer_s;
+typedef struct GBRewindBuffer_s GBRewindBuffer;
+
+struct GBAudioRecorder_s;
+typedef struct GBAudioRecorder_s GBAudioRecorder;
+
+struct GBDevicePool_s;
+typedef struct GBDevicePool_s GBDevicePool;
+
+struct GBMovie_s;
+typedef struct GBMovie_s GBMovie;
+
+struct GBRunAhead_s;
+typedef struct GBRunAhead_s GBRunAhead;
+
+struct GBRunAheadWorker_s;
+typedef struct GBRunAheadWorker_s GBRunAheadWorker;
+
+struct GBProfile_s;
+typedef struct GBProfile_s GBProfile;
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "core/definitions.h"
+#include "core/Device.h"
+#include "core/MMU.h"
+#include "core/APU.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "testHelper.h"
+
+#define CAPTURE_TEST_ROM "testroms/dmg_sound/dmg_sound.gb"
+#define CAPTURE_TEST_FILE "capture_test.tmp"
+// testNewRomDevice synthesizes at this rate
+#define CAPTURE_TEST_SAMPLE_RATE GB_TEST_SAMPLE_RATE
+// long enough for the recorder to hand several blocks to its thread
+#define CAPTURE_TEST_FRAMES 120
+
+#define CAPTURE_TEST_WAV_HEADER_SIZE 44
+#define CAPTURE_TEST_VGM_HEADER_SIZE 0x100
+#define CAPTURE_TEST_VGM_SAMPLE_RATE 44100
+// APU ticks per second, half the CPU clock
+#define CAPTURE_TEST_APU_HZ 2097152
+// more than one block of the logger's thread
+#define CAPTURE_TEST_VGM_WRITES 5000
+#define CAPTURE_TEST_VGM_CYCLES 200
+
+static uint32_t readCaptureLE16(const Byte* bytes) {
+    return bytes[0] | (bytes[1] << 8);
+}
+
+static uint32_t readCaptureLE32(const Byte* bytes) {
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static Byte* readCaptureFile(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    Byte* data = length > 0 ? malloc(length) : NULL;
+    if (data != NULL && fread(data, 1, length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *size = data != NULL ? (size_t)length : 0;
+    return data;
+}
+
+// Runs and drains the output like a player would, returns the stereo
+// frames produced
+static size_t runCaptureTestFrames(GB_device* device) {
+    size_t frames = 0;
+    for (int i = 0; i < CAPTURE_TEST_FRAMES; i++) {
+        GB_runFrame(device);
+        frames += GBApuSkipSamples(device, GBApuSamplesAvailable(device));
+    }
+    return frames;
+}
+
+// The file holds every frame the output got, after a header with the final
+// sizes
+static int testRecorder(GBAudioRecorderFormat format, const char* name) {
+    GB_device* device = testNewRomDevice(CAPTURE_TEST_ROM, GBApuAudioModeFull);
+    if (device == NULL || !GBApuStartRecording(device, CAPTURE_TEST_FILE, format)) {
+        printf("⛔️ %s recording could not start\n", name);
+        return 1;
+    }
+    size_t frames = runCaptureTestFrames(device);
+    bool closed = GBApuStopRecording(device);
+    GB_freeDevice(device);
+
+    size_t size;
+    Byte* data = readCaptureFile(CAPTURE_TEST_FILE, &size);
+    remove(CAPTURE_TEST_FILE);
+    int fails = 0;
+    size_t headerSize = format == GBAudioRecorderFormatWav ? CAPTURE_TEST_WAV_HEADER_SIZE : 0;
+    if (closed == false || data == NULL || frames == 0 || size != headerSize + frames * sizeof(GBSample)) {
+        printf("⛔️ %s recording holds %zu bytes for %zu frames\n", name, size, frames);
+        fails++;
+    } else if (format == GBAudioRecorderFormatWav) {
+        bool valid = memcmp(data, "RIFF", 4) == 0 && readCaptureLE32(data + 4) == size - 8 &&
+                     memcmp(data + 8, "WAVEfmt ", 8) == 0 && readCaptureLE32(data + 16) == 16 &&
+                     readCaptureLE16(data + 20) == 1 && readCaptureLE16(data + 22) == 2 &&
+                     readCaptureLE32(data + 24) == CAPTURE_TEST_SAMPLE_RATE &&
+                     readCaptureLE32(data + 28) == CAPTURE_TEST_SAMPLE_RATE * sizeof(GBSample) &&
+                     readCaptureLE16(data + 32) == sizeof(GBSample) && readCaptureLE16(data + 34) == 16 &&
+                     memcmp(data + 36, "data", 4) == 0 && readCaptureLE32(data + 40) == frames * sizeof(GBSample);
+        if (valid == false) {
+            printf("⛔️ %s header does not describe its %zu frames\n", name, frames);
+            fails++;
+        }
+    }
+    free(data);
+    return fails;
+}
+
+// Each stem gets exactly as many samples as the stereo output, every frame
+static int testStems(void) {
+    GB_device* device = testNewRomDevice(CAPTURE_TEST_ROM, GBApuAudioModeFull);
+    if (device == NULL || !GBApuSetStemsEnabled(device, true)) {
+        printf("⛔️ stems could not be enabled\n");
+        return 1;
+    }
+    int fails = 0;
+    int16_t stem[0x2000];
+    for (int i = 0; i < CAPTURE_TEST_FRAMES && fails == 0; i++) {
+        GB_runFrame(device);
+        size_t frames = GBApuSkipSamples(device, GBApuSamplesAvailable(device));
+        for (int ch = 0; ch < GBSoundChannelCount; ch++) {
+            size_t available = GBApuStemSamplesAvailable(device, ch);
+            size_t read = GBApuReadStemSamples(device, ch, stem, sizeof(stem) / sizeof(stem[0]));
+            if (available != frames || read != frames) {
+                printf("⛔️ stem %d has %zu samples for %zu stereo frames\n", ch + 1, available, frames);
+                fails++;
+            }
+        }
+    }
+    GB_freeDevice(device);
+    return fails;
+}
+
+// Drives the APU registers directly, so the log must hold exactly these
+// writes, in order, and waits adding up to the time that passed
+static int testVgmLog(void) {
+    GB_device* device = GB_newDevice();
+    if (!GBApuStartVgmLog(device, CAPTURE_TEST_FILE)) {
+        printf("⛔️ VGM log could not start\n");
+        GB_freeDevice(device);
+        return 1;
+    }
+    // the APU is off: the log starts with NR52 alone
+    Byte expected[2 * (CAPTURE_TEST_VGM_WRITES + 2)];
+    uint32_t writes = 0;
+    expected[2 * writes] = NR52;
+    expected[2 * writes++ + 1] = 0x00;
+    GBWriteToAPURegister(device, 0xFF26, 0x80);
+    expected[2 * writes] = NR52;
+    expected[2 * writes++ + 1] = 0x80;
+    uint64_t ticks = 0;
+    for (int i = 0; i < CAPTURE_TEST_VGM_WRITES; i++) {
+        GBApuStep(device, CAPTURE_TEST_VGM_CYCLES);
+        ticks += CAPTURE_TEST_VGM_CYCLES / 2;
+        Byte value = i & 0x77;
+        GBWriteToAPURegister(device, 0xFF24, value);
+        expected[2 * writes] = NR50;
+        expected[2 * writes++ + 1] = value;
+    }
+    GBApuStep(device, CAPTURE_TEST_VGM_CYCLES);
+    ticks += CAPTURE_TEST_VGM_CYCLES / 2;
+    bool closed = GBApuStopVgmLog(device);
+    GB_freeDevice(device);
+
+    size_t size;
+    Byte* data = readCaptureFile(CAPTURE_TEST_FILE, &size);
+    remove(CAPTURE_TEST_FILE);
+    if (closed == false || data == NULL || size <= CAPTURE_TEST_VGM_HEADER_SIZE) {
+        printf("⛔️ VGM log was not written\n");
+        free(data);
+        return 1;
+    }
+
+    uint32_t commands = 0;
+    uint64_t samples = 0;
+    bool ordered = true;
+    bool ended = false;
+    size_t position = CAPTURE_TEST_VGM_HEADER_SIZE;
+    while (position < size) {
+        Byte command = data[position];
+        if (command == 0xB3 && position + 3 <= size) {
+            ordered = ordered && commands < writes && data[position + 1] == expected[2 * commands] &&
+                      data[position + 2] == expected[2 * commands + 1];
+            commands++;
+            position += 3;
+        } else if (command == 0x61 && position + 3 <= size) {
+            samples += readCaptureLE16(data + position + 1);
+            position += 3;
+        } else if (command >= 0x70 && command <= 0x7F) {
+            samples += command - 0x70 + 1;
+            position++;
+        } else {
+            ended = command == 0x66 && position + 1 == size;
+            break;
+        }
+    }
+
+    int fails = 0;
+    uint64_t expectedSamples = ticks * CAPTURE_TEST_VGM_SAMPLE_RATE / CAPTURE_TEST_APU_HZ;
+    if (ended == false || commands != writes || ordered == false || samples != expectedSamples) {
+        printf("⛔️ VGM log holds %u of %u writes%s and %llu of %llu samples\n", commands, writes,
+               ordered ? "" : " out of order", (unsigned long long)samples, (unsigned long long)expectedSamples);
+        fails++;
+    }
+    bool valid = memcmp(data, "Vgm ", 4) == 0 && readCaptureLE32(data + 0x04) == size - 0x04 &&
+                 readCaptureLE32(data + 0x08) == 0x171 && readCaptureLE32(data + 0x18) == samples &&
+                 0x34 + readCaptureLE32(data + 0x34) == CAPTURE_TEST_VGM_HEADER_SIZE &&
+                 readCaptureLE32(data + 0x80) == 4194304;
+    if (valid == false) {
+        printf("⛔️ VGM header does not describe the log\n");
+        fails++;
+    }
+    free(data);
+    return fails;
+}
+
+int test_audio_capture() {
+    int fails = testRecorder(GBAudioRecorderFormatWav, "WAV");
+    fails += testRecorder(GBAudioRecorderFormatRaw, "raw");
+    fails += testStems();
+    fails += testVgmLog();
+    if (fails == 0) {
+        printf("✅ WAV and raw recordings, stems and VGM logs hold everything the APU produced\n");
+    }
+    return fails;
+}
@@ -4,8 +4,10 @@
 #include "core/MMU.h"
 #include <stdbool.h>
 #include <stdio.h>
-#include <strings.h>
+#include <stdlib.h>
+#include <string.h>
 #include "testHelper.h"
+#include "RomFarm.h"
 
 int test_dmg_sound() {
     char* testRoms[] = {
@@ -22,56 +24,103 @@ int test_dmg_sound() {
         "11-regs after power.gb",
         "12-wave write while on.gb",
     };
-    u_int32_t crcs[] = {
-        0xffffc95c, 
-        0xffff5938,
-        0xffffce8c,
-        0xffffe73f,
-        0xffff0cee,
-        0xffff9a86,
-        0xffffdc70,
-        0xffffc360,
-        0xffffa1c9,
-        0xffff1d11,
-        0xffff9b5a,
-        0xffff8b79,
-    };
-    u_int64_t steps[] = {
-        0x29cccc, 
-        0x6d87fb,
-        0x8ea30e,
-        0x2bb6a6,
-        0x2b79c9,
-        0x29bf05,
-        0x27a541,
-        0x2c95fc,
-        0x28112f,
-        0x421609,
-        0x28818c,
-        0x41f7d4,
-    };
+    // the ROMs stop on their own, this only bounds a hung one
+    uint64_t maxSteps = 0x1000000;
+
+    // with full synthesis as shipped, and headless as the farm runs them
+    GBApuAudioMode modes[] = {GBApuAudioModeFull, GBApuAudioModeHeadless};
+    const char* modeNames[] = {"full", "headless"};
 
     int fails = 0;
-    for (int i = 0; i < 12; i++) {
-        char* romName = testRoms[i];
-        u_int64_t romCrcs = crcs[i];
-        u_int64_t romSteps = steps[i];
-        char romPath[150];
-        strcpy(romPath, "testroms/dmg_sound/rom_singles/");
-        strcat(romPath, romName);
+    for (int mode = 0; mode < 2; mode++) {
+        for (int i = 0; i < 12; i++) {
+            char* romName = testRoms[i];
+            char romPath[150];
+            strcpy(romPath, "testroms/dmg_sound/rom_singles/");
+            strcat(romPath, romName);
 
-        int result = testRomWithCRC(romPath, romSteps, romCrcs);
-        if (result == GB_TEST_OK) {
-            printf("✅ %s succeed\n", romName);
-        } else {
-            printf("⛔️ %s failed\n", romName);
-            fails++;
+            GBTestRomResult result;
+            testRomUntilDone(romPath, modes[mode], maxSteps, &result);
+            if (result.outcome == GBTestRomPassed) {
+                printf("✅ %s (%s) succeed\n", romName, modeNames[mode]);
+            } else {
+                printf("⛔️ %s (%s) failed\n%s", romName, modeNames[mode], result.text);
+                fails++;
+            }
         }
     }
     return fails;
 }
 
+static void printFarmResult(void* context, const GBRomFarmEntry* entry, uint32_t finished, uint32_t total) {
+    switch (entry->status) {
+        case GBRomFarmPassed:
+            printf("[%u/%u] ✅ %s (%.1f ms)\n", finished, total, entry->path, entry->milliseconds);
+            break;
+        case GBRomFarmFailed:
+            if (entry->result.outcome == GBTestRomFailed) {
+                printf("[%u/%u] ⛔️ %s failed (%.1f ms)\n%s", finished, total, entry->path,
+                       entry->milliseconds, entry->result.text);
+            } else if (entry->hasExpectedCrc) {
+                printf("[%u/%u] ⛔️ %s %s with crc 0x%08x, expected 0x%08x (%.1f ms)\n", finished, total, entry->path,
+                       entry->result.outcome == GBTestRomStalled ? "stalled" : "timed out",
+                       entry->result.crc, entry->expectedCrc, entry->milliseconds);
+            } else {
+                printf("[%u/%u] ⛔️ %s %s without a result (%.1f ms)\n", finished, total, entry->path,
+                       entry->result.outcome == GBTestRomStalled ? "stalled" : "timed out", entry->milliseconds);
+            }
+            break;
+        case GBRomFarmLoadError:
+            printf("[%u/%u] ⛔️ %s could not be loaded\n", finished, total, entry->path);
+            break;
+    }
+    fflush(stdout);
+}
+
+// tests --farm <manifest> [-j <threads>]
+static int runFarm(int argc, const char * argv[]) {
+    const char* manifest = NULL;
+    int threads = 0;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else {
+            manifest = argv[i];
+        }
+    }
+    if (manifest == NULL) {
+        printf("usage: %s --farm <manifest> [-j <threads>]\n", argv[0]);
+        return 2;
+    }
+    GBRomFarm* farm = GBRomFarmLoadManifest(manifest);
+    if (farm == NULL) {
+        printf("⛔️ could not read %s\n", manifest);
+        return 2;
+    }
+
+    GBRomFarmReport report = GBRomFarmRun(farm, threads, printFarmResult, NULL);
+    uint32_t total = report.passed + report.failed;
+    printf("----------------------------\n");
+    double wall = report.wallSeconds > 0 ? report.wallSeconds : 1e-9;
+    printf("%u passed, %u failed in %.2f s\n", report.passed, report.failed, report.wallSeconds);
+    printf("%.1f ROMs/s, %.1f M instructions/s, %.2fx speedup over %.2f s of CPU time\n",
+           total / wall, report.steps / wall / 1e6, report.cpuSeconds / wall, report.cpuSeconds);
+    GBRomFarmFree(farm);
+    return report.failed == 0 ? 0 : 1;
+}
+
 int main(int argc, const char * argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--farm") == 0) {
+        return runFarm(argc, argv);
+    }
+    // tests --golden[-update] <suite>
+    if (argc > 2 && strcmp(argv[1], "--golden") == 0) {
+        return testGoldenFrames(argv[2], false) == 0 ? 0 : 1;
+    }
+    if (argc > 2 && strcmp(argv[1], "--golden-update") == 0) {
+        return testGoldenFrames(argv[2], true) == 0 ? 0 : 1;
+    }
+
     printf("----------------------------\n");
     printf("Testing DMG sound roms\n");
     printf("----------------------------\n");
@@ -84,5 +133,50 @@ int main(int argc, const char * argv[]) {
         printf("⛔️ test_dmg_sound failed\n");
     }
     printf("----------------------------\n");
+    printf("Testing golden frames\n");
+    printf("----------------------------\n");
+    failTests += testGoldenFrames("tests/dmg_sound.golden", false);
+    printf("----------------------------\n");
+    printf("Testing serial port\n");
+    printf("----------------------------\n");
+    failTests += test_serial();
+    printf("----------------------------\n");
+    printf("Testing concurrent devices\n");
+    printf("----------------------------\n");
+    failTests += test_concurrent_devices();
+    printf("----------------------------\n");
+    printf("Testing save states\n");
+    printf("----------------------------\n");
+    failTests += test_save_state();
+    printf("----------------------------\n");
+    printf("Testing run-ahead\n");
+    printf("----------------------------\n");
+    failTests += test_run_ahead();
+    printf("----------------------------\n");
+    printf("Testing rewind\n");
+    printf("----------------------------\n");
+    failTests += test_rewind();
+    printf("----------------------------\n");
+    printf("Testing device pool\n");
+    printf("----------------------------\n");
+    failTests += test_device_pool();
+    printf("----------------------------\n");
+    printf("Testing movies\n");
+    printf("----------------------------\n");
+    failTests += test_movie();
+    printf("----------------------------\n");
+    printf("Testing audio capture\n");
+    printf("----------------------------\n");
+    failTests += test_audio_capture();
+    printf("----------------------------\n");
+    printf("Testing GBS player\n");
+    printf("----------------------------\n");
+    failTests += test_gbs_player();
+    printf("----------------------------\n");
+    if (failTests != 0) {
+        printf("⛔️ %d test(s) failed\n", failTests);
+        return 1;
+    }
+    printf("✅ all tests passed\n");
     return 0;
 }
@@ -0,0 +1,128 @@
+#include "core/definitions.h"
+#include "core/Device.h"
+#include "core/MMU.h"
+#include "core/APU.h"
+#include "core/DevicePool.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include "testHelper.h"
+
+#define DEVICE_POOL_TEST_ROM "testroms/dmg_sound/dmg_sound.gb"
+#define DEVICE_POOL_TEST_OTHER_ROM "testroms/dmg_sound/rom_singles/01-registers.gb"
+#define DEVICE_POOL_TEST_CAPACITY 3
+#define DEVICE_POOL_TEST_WARMUP_FRAMES 20
+#define DEVICE_POOL_TEST_FRAMES 30
+
+// Acquire, release and reuse of the pool slots, including the releases
+// that must be refused
+static int testDevicePoolSlots(GB_device* src) {
+    int fails = 0;
+    GBDevicePool* pool = GBDevicePoolCreate(DEVICE_POOL_TEST_CAPACITY);
+    GB_device* devices[DEVICE_POOL_TEST_CAPACITY];
+    for (int i = 0; i < DEVICE_POOL_TEST_CAPACITY; i++) {
+        devices[i] = GBDevicePoolAcquire(pool, src);
+        if (devices[i] == NULL) {
+            printf("⛔️ device pool: acquire %d of %d failed\n", i + 1, DEVICE_POOL_TEST_CAPACITY);
+            GBDevicePoolFree(pool);
+            return 1;
+        }
+    }
+    if (GBDevicePoolAcquire(pool, src) != NULL || GBDevicePoolAvailable(pool) != 0) {
+        printf("⛔️ device pool: acquired more devices than slots\n");
+        fails++;
+    }
+
+    GB_device* released = devices[1];
+    if (!GBDevicePoolRelease(pool, released) || GBDevicePoolAvailable(pool) != 1) {
+        printf("⛔️ device pool: release did not free the slot\n");
+        fails++;
+    }
+    if (GBDevicePoolRelease(pool, released) || GBDevicePoolAvailable(pool) != 1) {
+        printf("⛔️ device pool: a second release was accepted\n");
+        fails++;
+    }
+    if (GBDevicePoolRelease(pool, (GB_device*)((Byte*)devices[0] + GB_DEVICE_ALIGNMENT)) ||
+        GBDevicePoolRelease(pool, src) || GBDevicePoolAvailable(pool) != 1) {
+        printf("⛔️ device pool: released a pointer that is not one of its devices\n");
+        fails++;
+    }
+
+    // the freed slot comes back, with a fresh copy of the source
+    testRunFrames(devices[0], DEVICE_POOL_TEST_FRAMES);
+    GB_device* reused = GBDevicePoolAcquire(pool, devices[0]);
+    if (reused != released || testDeviceFingerprint(reused, 0) != testDeviceFingerprint(devices[0], 0)) {
+        printf("⛔️ device pool: the released slot was not reused with the new state\n");
+        fails++;
+    }
+    if (GBDevicePoolAvailable(pool) != 0) {
+        printf("⛔️ device pool: %u slots free after reuse\n", GBDevicePoolAvailable(pool));
+        fails++;
+    }
+    GBDevicePoolFree(pool);
+    return fails;
+}
+
+// A clone, a pool device and a device copied over must all run exactly
+// like the source, and borrow its ROM without ever freeing it
+static int testDeviceCopies(GB_device* src) {
+    int fails = 0;
+    uint64_t romHash = GB_romHash(src->mmu.rom, src->mmu.romSize);
+    GBDevicePool* pool = GBDevicePoolCreate(1);
+    GB_device* clone = GB_cloneDevice(src);
+    GB_device* pooled = GBDevicePoolAcquire(pool, src);
+    // owns another ROM, which the copy must release
+    GB_device* copied = testNewRomDevice(DEVICE_POOL_TEST_OTHER_ROM, GBApuAudioModeHeadless);
+    if (clone == NULL || pooled == NULL || copied == NULL) {
+        printf("⛔️ device copies could not be created\n");
+        return 1;
+    }
+    GB_copyDeviceState(copied, src);
+
+    GB_device* copies[] = {clone, pooled, copied};
+    const char* names[] = {"GB_cloneDevice", "GBDevicePoolAcquire", "GB_copyDeviceState"};
+    for (int i = 0; i < 3; i++) {
+        if (copies[i]->mmu.rom != src->mmu.rom || copies[i]->mmu.romShared == false) {
+            printf("⛔️ %s did not borrow the source ROM\n", names[i]);
+            fails++;
+        }
+    }
+    if (src->mmu.romShared) {
+        printf("⛔️ device copies: the source no longer owns its ROM\n");
+        fails++;
+    }
+
+    uint64_t expected = testRunFrames(src, DEVICE_POOL_TEST_FRAMES);
+    for (int i = 0; i < 3; i++) {
+        if (testRunFrames(copies[i], DEVICE_POOL_TEST_FRAMES) != expected) {
+            printf("⛔️ %s diverged from the source\n", names[i]);
+            fails++;
+        }
+    }
+
+    // dropping every copy leaves the source's ROM alone
+    GB_freeDevice(clone);
+    GBDevicePoolRelease(pool, pooled);
+    GBDevicePoolFree(pool);
+    GB_freeDevice(copied);
+    if (src->mmu.rom == NULL || GB_romHash(src->mmu.rom, src->mmu.romSize) != romHash) {
+        printf("⛔️ device copies: freeing a copy touched the source ROM\n");
+        fails++;
+    }
+    return fails;
+}
+
+int test_device_pool() {
+    GB_device* src = testNewRomDevice(DEVICE_POOL_TEST_ROM, GBApuAudioModeHeadless);
+    if (src == NULL) {
+        printf("⛔️ device pool test ROM could not be loaded\n");
+        return 1;
+    }
+    testRunFrames(src, DEVICE_POOL_TEST_WARMUP_FRAMES);
+    int fails = testDevicePoolSlots(src);
+    fails += testDeviceCopies(src);
+    if (fails == 0) {
+        printf("✅ device pool reuses slots and refuses bad releases, copies run like their source\n");
+    }
+    GB_freeDevice(src);
+    return fails;
+}
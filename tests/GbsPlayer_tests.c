@@ -0,0 +1,142 @@
+#include "core/definitions.h"
+#include "core/Device.h"
+#include "core/MMU.h"
+#include "core/GBSPlayer.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "testHelper.h"
+
+#define GBS_TEST_FILE "gbs_test.tmp"
+#define GBS_TEST_LOAD_ADDRESS 0x0400
+#define GBS_TEST_INIT_ADDRESS 0x0400
+#define GBS_TEST_PLAY_ADDRESS 0x0410
+// three banks: not a power of two, so wrapping is not a plain bit mask
+#define GBS_TEST_BANK_COUNT 3
+#define GBS_TEST_SONG 2
+#define GBS_TEST_PLAY_PERIODS 60
+
+// init stores the song index and what bank 3 (wrapping to 1) shows at
+// 0x4000, play counts its calls
+static const Byte gbsTestInit[] = {
+    0xEA, 0x02, 0xC0, // LD (0xC002),A
+    0x3E, GBS_TEST_BANK_COUNT, // LD A,3
+    0xEA, 0x00, 0x20, // LD (0x2000),A
+    0xFA, 0x00, 0x40, // LD A,(0x4000)
+    0xEA, 0x00, 0xC0, // LD (0xC000),A
+    0xC9              // RET
+};
+static const Byte gbsTestPlay[] = {
+    0x21, 0x01, 0xC0, // LD HL,0xC001
+    0x34,             // INC (HL)
+    0xC9              // RET
+};
+
+// Marker at the start of each switchable bank, bank 0 starts with the stub
+static Byte gbsTestBankMarker(int bank) {
+    return 0x11 * bank;
+}
+
+static bool writeGbsTestFile(void) {
+    size_t codeSize = GBS_TEST_BANK_COUNT * 0x4000 - GBS_TEST_LOAD_ADDRESS;
+    Byte* data = calloc(GBS_HEADER_SIZE + codeSize, 1);
+    if (data == NULL) {
+        return false;
+    }
+    memcpy(data, "GBS", 3);
+    data[0x03] = 1;
+    data[0x04] = GBS_TEST_SONG + 1;
+    data[0x05] = 1;
+    data[0x06] = GBS_TEST_LOAD_ADDRESS & 0xFF;
+    data[0x07] = GBS_TEST_LOAD_ADDRESS >> 8;
+    data[0x08] = GBS_TEST_INIT_ADDRESS & 0xFF;
+    data[0x09] = GBS_TEST_INIT_ADDRESS >> 8;
+    data[0x0A] = GBS_TEST_PLAY_ADDRESS & 0xFF;
+    data[0x0B] = GBS_TEST_PLAY_ADDRESS >> 8;
+    data[0x0C] = 0xFE;
+    data[0x0D] = 0xFF;
+    strcpy((char*)data + 0x10, "bank test");
+
+    Byte* code = data + GBS_HEADER_SIZE - GBS_TEST_LOAD_ADDRESS;
+    memcpy(code + GBS_TEST_INIT_ADDRESS, gbsTestInit, sizeof(gbsTestInit));
+    memcpy(code + GBS_TEST_PLAY_ADDRESS, gbsTestPlay, sizeof(gbsTestPlay));
+    for (int bank = 1; bank < GBS_TEST_BANK_COUNT; bank++) {
+        code[bank * 0x4000] = gbsTestBankMarker(bank);
+    }
+
+    FILE* file = fopen(GBS_TEST_FILE, "wb");
+    bool written = file != NULL && fwrite(data, 1, GBS_HEADER_SIZE + codeSize, file) == GBS_HEADER_SIZE + codeSize;
+    if (file != NULL && fclose(file) != 0) {
+        written = false;
+    }
+    free(data);
+    return written;
+}
+
+// Every bank number wraps to the ROM size, and whatever lands on bank 0
+// selects bank 1
+static int testGbsBankSwitch(GB_device* device) {
+    int fails = 0;
+    for (int value = 0; value < 0x100; value++) {
+        GB_deviceWriteByte(device, 0x2000, value);
+        int bank = value % GBS_TEST_BANK_COUNT;
+        if (bank == 0) {
+            bank = 1;
+        }
+        Byte marker = GB_deviceReadByte(device, 0x4000);
+        if (marker != gbsTestBankMarker(bank)) {
+            printf("⛔️ GBS: writing %02x to 0x2000 maps %02x at 0x4000, bank %d expected\n", value, marker, bank);
+            fails++;
+        }
+    }
+    return fails;
+}
+
+int test_gbs_player() {
+    if (!writeGbsTestFile()) {
+        printf("⛔️ GBS test file could not be written\n");
+        return 1;
+    }
+    GB_device* device = GB_newDevice();
+    GBSPlayer* player = GBSPlayerOpen(device, GBS_TEST_FILE);
+    remove(GBS_TEST_FILE);
+    if (player == NULL) {
+        printf("⛔️ GBS test file could not be opened\n");
+        GB_freeDevice(device);
+        return 1;
+    }
+
+    int fails = 0;
+    if (!GBSPlayerStartSong(player, GBS_TEST_SONG)) {
+        printf("⛔️ GBS: song %d did not start\n", GBS_TEST_SONG);
+        fails++;
+    }
+    if (GB_deviceReadByte(device, 0xC002) != GBS_TEST_SONG ||
+        GB_deviceReadByte(device, 0xC000) != gbsTestBankMarker(1)) {
+        printf("⛔️ GBS: init got song %d and read %02x from the wrapped bank\n",
+               GB_deviceReadByte(device, 0xC002), GB_deviceReadByte(device, 0xC000));
+        fails++;
+    }
+    if (GBSPlayerStartSong(player, GBS_TEST_SONG + 1)) {
+        printf("⛔️ GBS: started a song past the last one\n");
+        fails++;
+    }
+
+    // one play call per VBlank period, the first one a period after init:
+    // the call due right at the end is left to the next render
+    GBSPlayerRender(player, GBS_TEST_PLAY_PERIODS * GBS_VBLANK_CYCLES);
+    if (GB_deviceReadByte(device, 0xC001) != GBS_TEST_PLAY_PERIODS - 1) {
+        printf("⛔️ GBS: play was called %d times in %d periods\n", GB_deviceReadByte(device, 0xC001),
+               GBS_TEST_PLAY_PERIODS);
+        fails++;
+    }
+
+    fails += testGbsBankSwitch(device);
+    if (fails == 0) {
+        printf("✅ GBS player calls init and play, bank switches never map bank 0\n");
+    }
+    GBSPlayerFree(player);
+    GB_freeDevice(device);
+    return fails;
+}
@@ -0,0 +1,180 @@
+#include "core/definitions.h"
+#include "core/Device.h"
+#include "core/MMU.h"
+#include "core/APU.h"
+#include "core/FrameHash.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "testHelper.h"
+
+// Golden-frame suites list frame hashes to check per ROM:
+//
+//     # comment
+//     rom <path>
+//     <frame> <hash>
+//     ...
+//
+// Frame n is the picture after the nth GB_runFrame since the ROM was
+// loaded; frames must go up within a ROM. The hash is GB_frame_hash in
+// hex, or '-' for a frame whose hash is not recorded yet (see update).
+
+#define GOLDEN_LINE_SIZE 1024
+
+typedef enum {
+    GoldenLineOther,
+    GoldenLineRom,
+    GoldenLineFrame,
+} GoldenLineKind;
+
+struct GoldenLine_s {
+    GoldenLineKind kind;
+    char* text;
+    uint32_t frame;
+    bool hasHash;
+    uint64_t hash;
+};
+
+typedef struct GoldenLine_s GoldenLine;
+
+static char* _copyString(const char* text) {
+    size_t length = strlen(text);
+    char* copy = malloc(length + 1);
+    if (copy != NULL) {
+        memcpy(copy, text, length + 1);
+    }
+    return copy;
+}
+
+static GoldenLine* _readGoldenSuite(const char* path, int* count) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return NULL;
+    }
+    int capacity = 64;
+    GoldenLine* lines = malloc(sizeof(GoldenLine) * capacity);
+    *count = 0;
+
+    char text[GOLDEN_LINE_SIZE];
+    while (lines != NULL && fgets(text, sizeof(text), file) != NULL) {
+        text[strcspn(text, "\r\n")] = '\0';
+        if (*count == capacity) {
+            capacity *= 2;
+            GoldenLine* grown = realloc(lines, sizeof(GoldenLine) * capacity);
+            if (grown == NULL) {
+                break;
+            }
+            lines = grown;
+        }
+        GoldenLine* line = &lines[(*count)++];
+        memset(line, 0, sizeof(GoldenLine));
+        line->text = _copyString(text);
+
+        char* end;
+        unsigned long frame = strtoul(text, &end, 10);
+        if (strncmp(text, "rom ", 4) == 0) {
+            line->kind = GoldenLineRom;
+        } else if (end != text) {
+            line->kind = GoldenLineFrame;
+            line->frame = (uint32_t)frame;
+            while (*end == ' ' || *end == '\t') {
+                end++;
+            }
+            if (*end != '-') {
+                char* hashEnd;
+                line->hash = strtoull(end, &hashEnd, 16);
+                line->hasHash = hashEnd != end;
+            }
+        }
+    }
+    fclose(file);
+    return lines;
+}
+
+static bool _writeGoldenSuite(const char* path, GoldenLine* lines, int count) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        if (lines[i].kind == GoldenLineFrame) {
+            fprintf(file, "%u %016llx\n", lines[i].frame, (unsigned long long)lines[i].hash);
+        } else {
+            fprintf(file, "%s\n", lines[i].text);
+        }
+    }
+    return fclose(file) == 0;
+}
+
+int testGoldenFrames(const char* suitePath, bool update) {
+    int count;
+    GoldenLine* lines = _readGoldenSuite(suitePath, &count);
+    if (lines == NULL) {
+        printf("⛔️ could not read %s\n", suitePath);
+        return 1;
+    }
+
+    int fails = 0;
+    int checked = 0;
+    GB_device* device = NULL;
+    const char* romPath = NULL;
+    uint32_t frame = 0;
+    for (int i = 0; i < count; i++) {
+        GoldenLine* line = &lines[i];
+        if (line->kind == GoldenLineRom) {
+            if (device != NULL) {
+                GB_freeDevice(device);
+            }
+            romPath = line->text + 4;
+            frame = 0;
+            device = GB_newDevice();
+            GBApuSetAudioMode(device, GBApuAudioModeHeadless);
+            if (GB_deviceloadRom(device, romPath) != GB_CARTRIDGE_SUCCESS) {
+                printf("⛔️ %s could not be loaded\n", romPath);
+                fails++;
+                GB_freeDevice(device);
+                device = NULL;
+            }
+            continue;
+        }
+        if (line->kind != GoldenLineFrame || device == NULL) {
+            continue;
+        }
+        if (line->frame < frame) {
+            printf("⛔️ %s: frame %u listed after frame %u\n", romPath, line->frame, frame);
+            fails++;
+            continue;
+        }
+        while (frame < line->frame) {
+            GB_runFrame(device);
+            frame++;
+        }
+        uint64_t hash = GB_frame_hash(device);
+        checked++;
+        if (update) {
+            line->hash = hash;
+            line->hasHash = true;
+        } else if (line->hasHash == false || hash != line->hash) {
+            printf("⛔️ %s frame %u hash %016llx, expected %016llx\n", romPath, frame,
+                   (unsigned long long)hash, (unsigned long long)line->hash);
+            fails++;
+        }
+    }
+    if (device != NULL) {
+        GB_freeDevice(device);
+    }
+
+    if (update && fails == 0 && _writeGoldenSuite(suitePath, lines, count) == false) {
+        printf("⛔️ could not write %s\n", suitePath);
+        fails++;
+    }
+    if (fails == 0) {
+        printf("✅ %d golden frames %s\n", checked, update ? "recorded" : "match");
+    }
+    for (int i = 0; i < count; i++) {
+        free(lines[i].text);
+    }
+    free(lines);
+    return fails;
+}
@@ -0,0 +1,122 @@
+#include "core/definitions.h"
+#include "core/Device.h"
+#include "core/MMU.h"
+#include "core/APU.h"
+#include "core/Movie.h"
+#include "core/SaveState.h"
+#include "core/FrameHash.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "testHelper.h"
+
+#define MOVIE_TEST_ROM "testroms/dmg_sound/dmg_sound.gb"
+#define MOVIE_TEST_FILE "movie_test.tmp"
+#define MOVIE_TEST_WARMUP_FRAMES 10
+#define MOVIE_TEST_FRAMES 100
+#define MOVIE_TEST_KEYFRAME_INTERVAL 16
+
+static GBJoypadState movieTestInput(int frame) {
+    GBJoypadState joypad;
+    memset(&joypad, 0, sizeof(joypad));
+    joypad.aPressed = (frame / 5) % 2;
+    joypad.downPressed = frame % 11 < 3;
+    joypad.startPressed = frame % 37 == 0;
+    return joypad;
+}
+
+// The input is part of it: the ROM never reads the joypad, the frames alone
+// would match with any input
+static uint64_t movieTestFingerprint(GB_device* device) {
+    return GB_hash64(&device->mmu.joypadState, sizeof(device->mmu.joypadState), testDeviceFingerprint(device, 0));
+}
+
+// Plays from the current frame to the end, every frame must match the
+// recording
+static int replayMovieTest(GBMovie* movie, const uint64_t* recorded, const char* what) {
+    while (GBMovieCurrentFrame(movie) < GBMovieFrameCount(movie)) {
+        uint32_t frame = GBMovieCurrentFrame(movie);
+        GBMoviePlayFrame(movie);
+        GB_runFrame(movie->device);
+        if (movieTestFingerprint(movie->device) != recorded[frame]) {
+            printf("⛔️ movie: %s diverged at frame %u\n", what, frame);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int seekMovieTest(GBMovie* movie, uint32_t frame, const uint64_t* recorded, const char* what) {
+    if (!GBMovieSeek(movie, frame) || GBMovieCurrentFrame(movie) != frame) {
+        printf("⛔️ movie: %s did not reach frame %u\n", what, frame);
+        return 1;
+    }
+    return replayMovieTest(movie, recorded, what);
+}
+
+int test_movie() {
+    GB_device* device = testNewRomDevice(MOVIE_TEST_ROM, GBApuAudioModeHeadless);
+    GB_device* loaded = testNewRomDevice(MOVIE_TEST_ROM, GBApuAudioModeHeadless);
+    if (device == NULL || loaded == NULL) {
+        printf("⛔️ movie test ROM could not be loaded\n");
+        return 1;
+    }
+    testRunFrames(device, MOVIE_TEST_WARMUP_FRAMES);
+
+    int fails = 0;
+    uint64_t recorded[MOVIE_TEST_FRAMES];
+    GBMovie* movie = GBMovieCreate(device, MOVIE_TEST_KEYFRAME_INTERVAL);
+    for (int frame = 0; frame < MOVIE_TEST_FRAMES; frame++) {
+        if (!GBMovieRecordFrame(movie, movieTestInput(frame))) {
+            printf("⛔️ movie: recording frame %d failed\n", frame);
+            fails++;
+        }
+        GB_runFrame(device);
+        recorded[frame] = movieTestFingerprint(device);
+    }
+
+    // back to the start, into the middle (from a keyframe, then playing
+    // forward from where the device already is), then to the end
+    fails += seekMovieTest(movie, 0, recorded, "replay from the start");
+    fails += seekMovieTest(movie, 57, recorded, "replay from a seek back");
+    fails += seekMovieTest(movie, 2 * MOVIE_TEST_KEYFRAME_INTERVAL + 2, recorded, "replay from a keyframe");
+    GBMovieSeek(movie, 2 * MOVIE_TEST_KEYFRAME_INTERVAL + 2);
+    fails += seekMovieTest(movie, 3 * MOVIE_TEST_KEYFRAME_INTERVAL - 1, recorded, "replay from a seek forward");
+    fails += seekMovieTest(movie, MOVIE_TEST_FRAMES, recorded, "seek to the end");
+
+    // a saved movie plays back the same on another device
+    if (GBMovieSave(movie, MOVIE_TEST_FILE) != GB_STATE_SUCCESS) {
+        printf("⛔️ movie: GBMovieSave failed\n");
+        fails++;
+    }
+    GBMovie* copy = GBMovieLoad(loaded, MOVIE_TEST_FILE);
+    remove(MOVIE_TEST_FILE);
+    if (copy == NULL || GBMovieFrameCount(copy) != MOVIE_TEST_FRAMES) {
+        printf("⛔️ movie: the saved movie did not load\n");
+        fails++;
+    } else {
+        fails += replayMovieTest(copy, recorded, "loaded movie");
+    }
+    GBMovieFree(copy);
+
+    // a keyframe that cannot be captured stops the recording there
+    uint32_t end = 4 * MOVIE_TEST_KEYFRAME_INTERVAL;
+    GBMovieSeek(movie, end - 1);
+    GBMovieRecordFrame(movie, movieTestInput(0));
+    GB_runFrame(device);
+    movie->stateSize--;
+    bool recordedWithoutKeyframe = GBMovieRecordFrame(movie, movieTestInput(0));
+    movie->stateSize++;
+    if (recordedWithoutKeyframe || GBMovieFrameCount(movie) != end || GBMovieCurrentFrame(movie) != end) {
+        printf("⛔️ movie: a frame was recorded without its keyframe\n");
+        fails++;
+    }
+
+    if (fails == 0) {
+        printf("✅ movie replays %d frames the same after seeks, a save and a load\n", MOVIE_TEST_FRAMES);
+    }
+    GBMovieFree(movie);
+    GB_freeDevice(loaded);
+    GB_freeDevice(device);
+    return fails;
+}
@@ -0,0 +1,88 @@
+#include "core/definitions.h"
+#include "core/Device.h"
+#include "core/PPU.h"
+#include "core/MMU.h"
+#include "core/APU.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "testHelper.h"
+
+#define GB_STRESS_THREADS 8
+#define GB_STRESS_DEVICES_PER_THREAD 3
+#define GB_STRESS_FRAMES 60
+
+static const char* stressRoms[] = {
+    "testroms/dmg_sound/rom_singles/01-registers.gb",
+    "testroms/dmg_sound/rom_singles/03-trigger.gb",
+    "testroms/dmg_sound/rom_singles/09-wave read while on.gb",
+    "testroms/dmg_sound/rom_singles/12-wave write while on.gb",
+};
+#define GB_STRESS_ROM_COUNT (sizeof(stressRoms) / sizeof(stressRoms[0]))
+
+struct GBStressJob_s {
+    int firstDevice;
+    uint64_t hashes[GB_STRESS_DEVICES_PER_THREAD];
+};
+
+typedef struct GBStressJob_s GBStressJob;
+
+// FNV-1a of every frame buffer the device produced, chained
+static uint64_t runDevice(const char* romPath) {
+    GB_device* device = GB_newDevice();
+    GBApuSetSampleRate(device, 48000);
+    GB_deviceloadRom(device, romPath);
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int frame = 0; frame < GB_STRESS_FRAMES; frame++) {
+        GB_runFrame(device);
+        GBApuSkipSamples(device, GBApuSamplesAvailable(device));
+        const uint8_t* pixels = (const uint8_t*)device->ppu.frameBuffer;
+        for (size_t i = 0; i < sizeof(device->ppu.frameBuffer); i++) {
+            hash = (hash ^ pixels[i]) * 0x100000001b3ULL;
+        }
+    }
+    GB_freeDevice(device);
+    return hash;
+}
+
+static void* runStressJob(void* context) {
+    GBStressJob* job = context;
+    for (int i = 0; i < GB_STRESS_DEVICES_PER_THREAD; i++) {
+        job->hashes[i] = runDevice(stressRoms[(job->firstDevice + i) % GB_STRESS_ROM_COUNT]);
+    }
+    return NULL;
+}
+
+int test_concurrent_devices() {
+    uint64_t expected[GB_STRESS_ROM_COUNT];
+    for (size_t i = 0; i < GB_STRESS_ROM_COUNT; i++) {
+        expected[i] = runDevice(stressRoms[i]);
+    }
+
+    pthread_t threads[GB_STRESS_THREADS];
+    GBStressJob jobs[GB_STRESS_THREADS];
+    for (int t = 0; t < GB_STRESS_THREADS; t++) {
+        jobs[t].firstDevice = t * GB_STRESS_DEVICES_PER_THREAD;
+        pthread_create(&threads[t], NULL, runStressJob, &jobs[t]);
+    }
+
+    int fails = 0;
+    for (int t = 0; t < GB_STRESS_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        for (int i = 0; i < GB_STRESS_DEVICES_PER_THREAD; i++) {
+            int rom = (jobs[t].firstDevice + i) % GB_STRESS_ROM_COUNT;
+            if (jobs[t].hashes[i] != expected[rom]) {
+                printf("⛔️ thread %d device %d diverged from the single-threaded run\n", t, i);
+                fails++;
+            }
+        }
+    }
+    if (fails == 0) {
+        printf("✅ %d devices on %d threads match the single-threaded run\n",
+            GB_STRESS_THREADS * GB_STRESS_DEVICES_PER_THREAD, GB_STRESS_THREADS);
+    }
+    return fails;
+}
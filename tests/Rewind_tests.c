@@ -0,0 +1,94 @@
+#include "core/definitions.h"
+#include "core/Device.h"
+#include "core/MMU.h"
+#include "core/APU.h"
+#include "core/Rewind.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "testHelper.h"
+
+#define REWIND_TEST_ROM "testroms/dmg_sound/dmg_sound.gb"
+#define REWIND_TEST_FRAMES 120
+#define REWIND_TEST_FRAME_INTERVAL 2
+#define REWIND_TEST_KEYFRAME_INTERVAL 8
+#define REWIND_TEST_BUDGET (4 << 20)
+// holds a few keyframe groups, not all of them
+#define REWIND_TEST_SMALL_BUDGET (24 << 10)
+
+// Runs forward recording the state of every capture, then steps back
+// through the history, which must hand back the same states newest first
+static int rewindTestRun(size_t budget, bool evicts, const char* name) {
+    GB_device* device = testNewRomDevice(REWIND_TEST_ROM, GBApuAudioModeHeadless);
+    if (device == NULL) {
+        printf("⛔️ rewind test ROM could not be loaded\n");
+        return 1;
+    }
+    GBRewindBuffer* rewind = GBRewindCreate(device, budget, REWIND_TEST_FRAME_INTERVAL, REWIND_TEST_KEYFRAME_INTERVAL);
+    if (rewind == NULL) {
+        printf("⛔️ rewind (%s): GBRewindCreate failed\n", name);
+        GB_freeDevice(device);
+        return 1;
+    }
+    int fails = 0;
+    if (rewind->arenaSize + sizeof(GBRewindEntry) * rewind->entryCapacity > budget) {
+        printf("⛔️ rewind (%s): arena and entry table take more than the %zu byte budget\n", name, budget);
+        fails++;
+    }
+
+    uint64_t recorded[REWIND_TEST_FRAMES];
+    uint32_t captures = 0;
+    for (int frame = 0; frame < REWIND_TEST_FRAMES; frame++) {
+        GB_runFrame(device);
+        GBRewindOnFrame(rewind);
+        if (frame % REWIND_TEST_FRAME_INTERVAL == 0) {
+            recorded[captures++] = testDeviceFingerprint(device, 0);
+        }
+    }
+
+    uint32_t kept = GBRewindSnapshotCount(rewind);
+    if (kept == 0 || kept > captures || (kept < captures) != evicts) {
+        printf("⛔️ rewind (%s): %u snapshots kept out of %u captures\n", name, kept, captures);
+        fails++;
+    }
+    for (uint32_t step = 0; step < kept; step++) {
+        uint32_t index = captures - 1 - step;
+        if (!GBRewindStepBack(rewind)) {
+            printf("⛔️ rewind (%s): step back %u failed\n", name, step + 1);
+            fails++;
+            break;
+        }
+        if (testDeviceFingerprint(device, 0) != recorded[index]) {
+            printf("⛔️ rewind (%s): step back %u did not restore capture %u\n", name, step + 1, index);
+            fails++;
+            break;
+        }
+    }
+    if (GBRewindStepBack(rewind) || GBRewindSnapshotCount(rewind) != 0) {
+        printf("⛔️ rewind (%s): stepped back past the oldest snapshot\n", name);
+        fails++;
+    }
+    if (fails == 0) {
+        printf("✅ rewind (%s) stepped back through %u of %u captures\n", name, kept, captures);
+    }
+    GBRewindFree(rewind);
+    GB_freeDevice(device);
+    return fails;
+}
+
+int test_rewind() {
+    int fails = rewindTestRun(REWIND_TEST_BUDGET, false, "whole history");
+    fails += rewindTestRun(REWIND_TEST_SMALL_BUDGET, true, "evicting");
+    GB_device* device = testNewRomDevice(REWIND_TEST_ROM, GBApuAudioModeHeadless);
+    if (device == NULL) {
+        return fails + 1; // already reported by the runs above
+    }
+    GBRewindBuffer* rewind = GBRewindCreate(device, sizeof(GBRewindEntry), 1, 1);
+    if (rewind != NULL) {
+        printf("⛔️ rewind: a budget too small for one entry was accepted\n");
+        GBRewindFree(rewind);
+        fails++;
+    }
+    GB_freeDevice(device);
+    return fails;
+}
@@ -0,0 +1,306 @@
+#include "RomFarm.h"
+#include "testHelper.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define GB_ROM_FARM_MAX_THREADS 256
+
+// A worker's slice of the manifest, [begin, end) packed into one word so
+// the owner and thieves can both claim entries with a single CAS.
+struct GBRomFarmQueue_s {
+    _Atomic uint64_t range;
+    char padding[GB_ROM_FARM_CACHE_LINE - sizeof(uint64_t)];
+};
+
+typedef struct GBRomFarmQueue_s GBRomFarmQueue;
+
+struct GBRomFarmJob_s {
+    GBRomFarm* farm;
+    GBRomFarmQueue* queues;
+    int threads;
+    GBRomFarmResultCallback callback;
+    void* context;
+
+    pthread_mutex_t lock;
+    uint32_t finished;
+    uint32_t passed;
+    double cpuSeconds;
+    uint64_t steps;
+};
+
+typedef struct GBRomFarmJob_s GBRomFarmJob;
+
+struct GBRomFarmWorker_s {
+    GBRomFarmJob* job;
+    int index;
+};
+
+typedef struct GBRomFarmWorker_s GBRomFarmWorker;
+
+static uint64_t _GBRomFarmRange(uint32_t begin, uint32_t end) {
+    return ((uint64_t)end << 32) | begin;
+}
+
+static double _GBRomFarmClock(clockid_t clock) {
+    struct timespec now;
+    clock_gettime(clock, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static bool _GBRomFarmAddEntry(GBRomFarm* farm, const char* path, uint64_t maxSteps, bool hasCrc, uint32_t crc) {
+    if (farm->count == farm->capacity) {
+        uint32_t capacity = farm->capacity ? farm->capacity * 2 : 64;
+        GBRomFarmEntry* entries = realloc(farm->entries, sizeof(GBRomFarmEntry) * capacity);
+        if (entries == NULL) {
+            return false;
+        }
+        farm->entries = entries;
+        farm->capacity = capacity;
+    }
+    size_t length = strlen(path);
+    char* copy = malloc(length + 1);
+    if (copy == NULL) {
+        return false;
+    }
+    memcpy(copy, path, length + 1);
+
+    GBRomFarmEntry* entry = &farm->entries[farm->count++];
+    memset(entry, 0, sizeof(GBRomFarmEntry));
+    entry->path = copy;
+    entry->maxSteps = maxSteps;
+    entry->hasExpectedCrc = hasCrc;
+    entry->expectedCrc = crc;
+    return true;
+}
+
+GBRomFarm* GBRomFarmLoadManifest(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return NULL;
+    }
+    GBRomFarm* farm = calloc(1, sizeof(GBRomFarm));
+    if (farm == NULL) {
+        fclose(file);
+        return NULL;
+    }
+
+    char line[1024];
+    int lineNumber = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        lineNumber++;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        char* cursor = line;
+        while (*cursor == ' ' || *cursor == '\t') {
+            cursor++;
+        }
+        if (*cursor == '\0' || *cursor == '#') {
+            continue;
+        }
+
+        char* end;
+        uint64_t maxSteps = strtoull(cursor, &end, 0);
+        bool valid = end != cursor;
+        cursor = end;
+        while (*cursor == ' ' || *cursor == '\t') {
+            cursor++;
+        }
+        bool hasCrc = *cursor != '-';
+        uint32_t crc = 0;
+        if (hasCrc) {
+            crc = (uint32_t)strtoul(cursor, &end, 0);
+            valid = valid && end != cursor;
+            cursor = end;
+        } else {
+            cursor++;
+        }
+        while (*cursor == ' ' || *cursor == '\t') {
+            cursor++;
+        }
+        if (valid == false || *cursor == '\0') {
+            fprintf(stderr, "%s:%d: expected <max steps> <crc or -> <path>\n", path, lineNumber);
+            continue;
+        }
+        if (_GBRomFarmAddEntry(farm, cursor, maxSteps, hasCrc, crc) == false) {
+            fclose(file);
+            GBRomFarmFree(farm);
+            return NULL;
+        }
+    }
+    fclose(file);
+    return farm;
+}
+
+void GBRomFarmFree(GBRomFarm* farm) {
+    if (farm == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < farm->count; i++) {
+        free(farm->entries[i].path);
+    }
+    free(farm->entries);
+    free(farm);
+}
+
+// Takes the front entry of the worker's own slice.
+static bool _GBRomFarmPop(GBRomFarmQueue* queue, uint32_t* index) {
+    uint64_t range = atomic_load_explicit(&queue->range, memory_order_relaxed);
+    for (;;) {
+        uint32_t begin = (uint32_t)range;
+        uint32_t end = (uint32_t)(range >> 32);
+        if (begin >= end) {
+            return false;
+        }
+        if (atomic_compare_exchange_weak_explicit(&queue->range, &range, _GBRomFarmRange(begin + 1, end),
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            *index = begin;
+            return true;
+        }
+    }
+}
+
+// Moves the back half of another worker's slice into the (empty) slice of
+// worker `thief`. Victims are scanned starting from the next worker so
+// thieves spread out instead of all hitting worker 0.
+static bool _GBRomFarmSteal(GBRomFarmJob* job, int thief) {
+    for (int offset = 1; offset < job->threads; offset++) {
+        GBRomFarmQueue* victim = &job->queues[(thief + offset) % job->threads];
+        uint64_t range = atomic_load_explicit(&victim->range, memory_order_relaxed);
+        for (;;) {
+            uint32_t begin = (uint32_t)range;
+            uint32_t end = (uint32_t)(range >> 32);
+            if (begin >= end) {
+                break;
+            }
+            uint32_t split = end - (end - begin + 1) / 2;
+            if (atomic_compare_exchange_weak_explicit(&victim->range, &range, _GBRomFarmRange(begin, split),
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                atomic_store_explicit(&job->queues[thief].range, _GBRomFarmRange(split, end), memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void _GBRomFarmRunEntry(GBRomFarmJob* job, GBRomFarmEntry* entry) {
+    double start = _GBRomFarmClock(CLOCK_MONOTONIC);
+    // thread CPU time stays honest when there are more threads than cores
+    double cpuStart = _GBRomFarmClock(CLOCK_THREAD_CPUTIME_ID);
+    // throughput first: full synthesis is covered by the default suite
+    testRomUntilDone(entry->path, GBApuAudioModeHeadless, entry->maxSteps, &entry->result);
+    switch (entry->result.outcome) {
+        case GBTestRomPassed:
+            entry->status = GBRomFarmPassed;
+            break;
+        case GBTestRomFailed:
+            entry->status = GBRomFarmFailed;
+            break;
+        case GBTestRomStalled:
+        case GBTestRomTimedOut:
+            entry->status = entry->hasExpectedCrc && entry->result.crc == entry->expectedCrc ? GBRomFarmPassed : GBRomFarmFailed;
+            break;
+        case GBTestRomLoadError:
+            entry->status = GBRomFarmLoadError;
+            break;
+    }
+    entry->milliseconds = (_GBRomFarmClock(CLOCK_MONOTONIC) - start) * 1000.0;
+    double cpuSeconds = _GBRomFarmClock(CLOCK_THREAD_CPUTIME_ID) - cpuStart;
+
+    pthread_mutex_lock(&job->lock);
+    job->finished++;
+    job->cpuSeconds += cpuSeconds;
+    job->steps += entry->result.steps;
+    if (entry->status == GBRomFarmPassed) {
+        job->passed++;
+    }
+    if (job->callback != NULL) {
+        job->callback(job->context, entry, job->finished, job->farm->count);
+    }
+    pthread_mutex_unlock(&job->lock);
+}
+
+static void* _GBRomFarmWorkerMain(void* context) {
+    GBRomFarmWorker* worker = context;
+    GBRomFarmJob* job = worker->job;
+    GBRomFarmQueue* queue = &job->queues[worker->index];
+
+    uint32_t index;
+    for (;;) {
+        if (_GBRomFarmPop(queue, &index)) {
+            _GBRomFarmRunEntry(job, &job->farm->entries[index]);
+        } else if (_GBRomFarmSteal(job, worker->index) == false) {
+            // entries are never added back, so nothing left to steal means done
+            break;
+        }
+    }
+    return NULL;
+}
+
+GBRomFarmReport GBRomFarmRun(GBRomFarm* farm, int threads, GBRomFarmResultCallback callback, void* context) {
+    GBRomFarmReport report = {0};
+    if (threads <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cores > 0 ? (int)cores : 1;
+    }
+    if (threads > GB_ROM_FARM_MAX_THREADS) {
+        threads = GB_ROM_FARM_MAX_THREADS;
+    }
+    if (farm->count > 0 && (uint32_t)threads > farm->count) {
+        threads = farm->count;
+    }
+
+    GBRomFarmJob job = {
+        .farm = farm,
+        .threads = threads,
+        .callback = callback,
+        .context = context,
+    };
+    job.queues = aligned_alloc(GB_ROM_FARM_CACHE_LINE, sizeof(GBRomFarmQueue) * threads);
+    if (job.queues == NULL) {
+        report.failed = farm->count;
+        return report;
+    }
+    for (int i = 0; i < threads; i++) {
+        uint32_t begin = (uint32_t)((uint64_t)farm->count * i / threads);
+        uint32_t end = (uint32_t)((uint64_t)farm->count * (i + 1) / threads);
+        atomic_init(&job.queues[i].range, _GBRomFarmRange(begin, end));
+    }
+    pthread_mutex_init(&job.lock, NULL);
+
+    double start = _GBRomFarmClock(CLOCK_MONOTONIC);
+    pthread_t handles[GB_ROM_FARM_MAX_THREADS];
+    GBRomFarmWorker workers[GB_ROM_FARM_MAX_THREADS];
+    int started = 0;
+    for (int i = 0; i < threads; i++) {
+        workers[i].job = &job;
+        workers[i].index = i;
+        if (pthread_create(&handles[i], NULL, _GBRomFarmWorkerMain, &workers[i]) != 0) {
+            break;
+        }
+        started++;
+    }
+    if (started == 0) {
+        // no threads available, run the whole manifest here
+        _GBRomFarmWorkerMain(&workers[0]);
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(handles[i], NULL);
+    }
+    report.wallSeconds = _GBRomFarmClock(CLOCK_MONOTONIC) - start;
+
+    pthread_mutex_destroy(&job.lock);
+    free(job.queues);
+
+    report.passed = job.passed;
+    report.failed = farm->count - job.passed;
+    report.cpuSeconds = job.cpuSeconds;
+    report.steps = job.steps;
+    return report;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "testHelper.h"
+
+// Headless batch runner for test ROM catalogs.
+//
+// A manifest lists one ROM per line as
+//
+//     <max steps> <expected crc> <path>
+//
+// with the numbers in C notation (0x... for hex) and the path running to
+// the end of the line, so it may contain spaces. Paths are relative to the
+// working directory. Blank lines and lines starting with '#' are ignored.
+//
+// A ROM stops as soon as it reports a Blargg result, which then decides
+// pass or fail. ROMs that stall or run out of steps instead are judged by
+// their screen CRC. A crc of '-' means the ROM must report a result.
+//
+// GBRomFarmRun spreads the ROMs over a pool of threads. Each thread owns a
+// contiguous slice of the manifest and steals half of another thread's
+// remaining slice when its own runs dry, so a few slow ROMs never leave
+// the other cores idle.
+
+#define GB_ROM_FARM_CACHE_LINE 64
+
+enum GBRomFarmStatus_e {
+    GBRomFarmPassed,
+    GBRomFarmFailed,
+    GBRomFarmLoadError,
+};
+
+typedef enum GBRomFarmStatus_e GBRomFarmStatus;
+
+struct GBRomFarmEntry_s {
+    char* path;
+    uint64_t maxSteps;
+    bool hasExpectedCrc;
+    uint32_t expectedCrc;
+
+    // filled in by GBRomFarmRun
+    GBRomFarmStatus status;
+    GBTestRomResult result;
+    double milliseconds;
+};
+
+typedef struct GBRomFarmEntry_s GBRomFarmEntry;
+
+// Called once per ROM as soon as it finishes, from the worker thread that
+// ran it. Calls are serialized, so the callback may print without locking.
+typedef void (*GBRomFarmResultCallback)(void* context, const GBRomFarmEntry* entry, uint32_t finished, uint32_t total);
+
+struct GBRomFarm_s {
+    GBRomFarmEntry* entries;
+    uint32_t count;
+    uint32_t capacity;
+};
+
+typedef struct GBRomFarm_s GBRomFarm;
+
+struct GBRomFarmReport_s {
+    uint32_t passed;
+    uint32_t failed;
+    double wallSeconds;
+    // CPU time summed over all ROMs, about what a single thread would take
+    double cpuSeconds;
+    // instructions actually run across all ROMs
+    uint64_t steps;
+};
+
+typedef struct GBRomFarmReport_s GBRomFarmReport;
+
+// Returns NULL if the file cannot be read. Malformed lines are reported on
+// stderr and skipped.
+GBRomFarm* GBRomFarmLoadManifest(const char* path);
+void GBRomFarmFree(GBRomFarm* farm);
+
+// threads <= 0 uses one thread per online core.
+GBRomFarmReport GBRomFarmRun(GBRomFarm* farm, int threads, GBRomFarmResultCallback callback, void* context);
@@ -0,0 +1,180 @@
+#include "core/definitions.h"
+#include "core/Device.h"
+#include "core/MMU.h"
+#include "core/APU.h"
+#include "core/SaveState.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "testHelper.h"
+
+#define STATE_TEST_ROM "testroms/dmg_sound/dmg_sound.gb"
+#define STATE_TEST_OTHER_ROM "testroms/dmg_sound/rom_singles/01-registers.gb"
+#define STATE_TEST_FILE "savestate_test.tmp"
+#define STATE_TEST_WARMUP_FRAMES 30
+#define STATE_TEST_FRAMES 20
+
+#define STATE_TEST_HEADER_SIZE 12
+#define STATE_TEST_SECTION_HEADER_SIZE 8
+
+static uint32_t readLE32(const Byte* bytes) {
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static void writeLE32(Byte* bytes, uint32_t value) {
+    bytes[0] = value & 0xFF;
+    bytes[1] = (value >> 8) & 0xFF;
+    bytes[2] = (value >> 16) & 0xFF;
+    bytes[3] = value >> 24;
+}
+
+// Offset of a section header, or 0
+static size_t findStateSection(const Byte* state, size_t size, const char* tag) {
+    size_t position = STATE_TEST_HEADER_SIZE;
+    while (position + STATE_TEST_SECTION_HEADER_SIZE <= size) {
+        if (memcmp(state + position, tag, 4) == 0) {
+            return position;
+        }
+        position += STATE_TEST_SECTION_HEADER_SIZE + readLE32(state + position + 4);
+    }
+    return 0;
+}
+
+// Rewrites a version 2 state the way version 1 stored it: the MMU section
+// ends with the bit-level serial fields (3 x u32 + u8) instead of the
+// cycles left. Only valid without a transfer in flight.
+static Byte* makeVersion1State(const Byte* state, size_t size, size_t* outSize) {
+    size_t mmu = findStateSection(state, size, "MMU ");
+    if (mmu == 0) {
+        return NULL;
+    }
+    uint32_t mmuSize = readLE32(state + mmu + 4);
+    size_t serial = mmu + STATE_TEST_SECTION_HEADER_SIZE + mmuSize - 4;
+    size_t rest = mmu + STATE_TEST_SECTION_HEADER_SIZE + mmuSize;
+
+    *outSize = size - 4 + 13;
+    Byte* converted = calloc(1, *outSize);
+    memcpy(converted, state, serial);
+    memcpy(converted + serial + 13, state + rest, size - rest);
+    writeLE32(converted + 4, 1);
+    writeLE32(converted + mmu + 4, mmuSize - 4 + 13);
+    return converted;
+}
+
+// The fingerprint covers everything a load may touch: a rejected state must
+// leave it alone
+static int expectRejected(GB_device* device, const void* state, size_t size, int expected, const char* what) {
+    uint64_t before = testDeviceFingerprint(device, 0);
+    int result = GB_loadStateFromBuffer(device, state, size);
+    if (result != expected) {
+        printf("⛔️ save state: %s returned %d instead of %d\n", what, result, expected);
+        return 1;
+    }
+    if (testDeviceFingerprint(device, 0) != before) {
+        printf("⛔️ save state: %s was rejected but modified the device\n", what);
+        return 1;
+    }
+    return 0;
+}
+
+int test_save_state() {
+    GB_device* device = testNewRomDevice(STATE_TEST_ROM, GBApuAudioModeHeadless);
+    GB_device* other = testNewRomDevice(STATE_TEST_OTHER_ROM, GBApuAudioModeHeadless);
+    if (device == NULL || other == NULL) {
+        printf("⛔️ save state test ROMs could not be loaded\n");
+        return 1;
+    }
+    int fails = 0;
+    testRunFrames(device, STATE_TEST_WARMUP_FRAMES);
+
+    size_t size = GB_saveStateSize(device);
+    Byte* state = malloc(size);
+    if (GB_saveStateToBuffer(device, state, size) != (long)size) {
+        printf("⛔️ save state: GB_saveStateToBuffer did not write %zu bytes\n", size);
+        fails++;
+    }
+    if (GB_saveStateToBuffer(device, state, size - 1) != GB_STATE_BUFFER_SIZE) {
+        printf("⛔️ save state: a short buffer was not reported\n");
+        fails++;
+    }
+    GB_saveStateToBuffer(device, state, size);
+    if (GB_saveState(device, STATE_TEST_FILE) != GB_STATE_SUCCESS) {
+        printf("⛔️ save state: GB_saveState failed\n");
+        fails++;
+    }
+    uint64_t expected = testRunFrames(device, STATE_TEST_FRAMES);
+
+    // buffer round trip
+    if (GB_loadStateFromBuffer(device, state, size) != GB_STATE_SUCCESS ||
+        testRunFrames(device, STATE_TEST_FRAMES) != expected) {
+        printf("⛔️ save state: buffer round trip diverged\n");
+        fails++;
+    }
+    // file round trip
+    if (GB_loadState(device, STATE_TEST_FILE) != GB_STATE_SUCCESS ||
+        testRunFrames(device, STATE_TEST_FRAMES) != expected) {
+        printf("⛔️ save state: file round trip diverged\n");
+        fails++;
+    }
+    remove(STATE_TEST_FILE);
+    if (GB_loadState(device, STATE_TEST_FILE) != GB_STATE_FILE_ERROR) {
+        printf("⛔️ save state: a missing file was not reported\n");
+        fails++;
+    }
+
+    // version 1 states still load
+    size_t v1Size;
+    Byte* v1 = makeVersion1State(state, size, &v1Size);
+    if (v1 == NULL || GB_loadStateFromBuffer(device, v1, v1Size) != GB_STATE_SUCCESS ||
+        testRunFrames(device, STATE_TEST_FRAMES) != expected) {
+        printf("⛔️ save state: version 1 state did not load the same\n");
+        fails++;
+    }
+    free(v1);
+
+    // truncated states, cut inside the header, a section header and each section
+    size_t cuts[] = {0, 3, STATE_TEST_HEADER_SIZE + 4, size / 4, size / 2, size - 1};
+    for (size_t i = 0; i < sizeof(cuts) / sizeof(cuts[0]); i++) {
+        char what[64];
+        snprintf(what, sizeof(what), "a state cut at %zu bytes", cuts[i]);
+        fails += expectRejected(device, state, cuts[i], GB_STATE_FORMAT_ERROR, what);
+    }
+    const char* tags[] = {"CPU ", "MMU ", "PPU ", "APU "};
+    for (int i = 0; i < 4; i++) {
+        // the section claims one byte less, the next one starts a byte early
+        Byte* corrupt = malloc(size);
+        memcpy(corrupt, state, size);
+        size_t section = findStateSection(corrupt, size, tags[i]);
+        writeLE32(corrupt + section + 4, readLE32(corrupt + section + 4) - 1);
+        char what[64];
+        snprintf(what, sizeof(what), "a short %.3s section", tags[i]);
+        fails += expectRejected(device, corrupt, size, GB_STATE_FORMAT_ERROR, what);
+        free(corrupt);
+    }
+
+    // corrupt headers
+    Byte* corrupt = malloc(size);
+    memcpy(corrupt, state, size);
+    corrupt[0] ^= 0xFF;
+    fails += expectRejected(device, corrupt, size, GB_STATE_FORMAT_ERROR, "a bad magic");
+    memcpy(corrupt, state, size);
+    writeLE32(corrupt + 4, GB_STATE_VERSION + 1);
+    fails += expectRejected(device, corrupt, size, GB_STATE_FORMAT_ERROR, "a newer version");
+    memcpy(corrupt, state, size);
+    writeLE32(corrupt + findStateSection(corrupt, size, "PPU ") + 4, 0xFFFFFFF0);
+    fails += expectRejected(device, corrupt, size, GB_STATE_FORMAT_ERROR, "an oversized section");
+    free(corrupt);
+
+    // a state only loads into the ROM it was saved from
+    fails += expectRejected(other, state, size, GB_STATE_ROM_MISMATCH, "another ROM's state");
+
+    if (fails == 0) {
+        printf("✅ save states round trip, load version 1 and reject %zu bad states untouched\n",
+               sizeof(cuts) / sizeof(cuts[0]) + 8);
+    }
+    free(state);
+    GB_freeDevice(other);
+    GB_freeDevice(device);
+    return fails;
+}
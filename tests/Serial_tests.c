@@ -0,0 +1,120 @@
+#include "core/definitions.h"
+#include "core/Device.h"
+#include "core/MMU.h"
+#include "core/APU.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "testHelper.h"
+
+#define SERIAL_TEST_PROGRAM_START 0xC000
+
+struct SerialTestLog_s {
+    char bytes[8];
+    int count;
+    uint64_t cycles[8];
+};
+
+typedef struct SerialTestLog_s SerialTestLog;
+
+static void logSerialByte(void* sender, GB_device* device, Byte value) {
+    SerialTestLog* log = sender;
+    if (log->count < 8) {
+        log->cycles[log->count] = device->mmu.cycleCount;
+        log->bytes[log->count++] = value;
+    }
+}
+
+// Sends "Hi" on the internal clock, waiting on SC bit 7 between bytes,
+// then parks in JR -2
+static const Byte serialTestProgram[] = {
+    0x3E, 'H',  0xE0, 0x01, 0x3E, 0x81, 0xE0, 0x02,
+    0xF0, 0x02, 0xCB, 0x7F, 0x20, 0xFA,
+    0x3E, 'i',  0xE0, 0x01, 0x3E, 0x81, 0xE0, 0x02,
+    0xF0, 0x02, 0xCB, 0x7F, 0x20, 0xFA,
+    0x18, 0xFE,
+};
+
+static GB_device* newSerialTestDevice(SerialTestLog* log) {
+    GB_device* device = GB_newDevice();
+    GBApuSetAudioMode(device, GBApuAudioModeHeadless);
+    if (GB_deviceloadRom(device, "testroms/dmg_sound/rom_singles/01-registers.gb") != GB_CARTRIDGE_SUCCESS) {
+        GB_freeDevice(device);
+        return NULL;
+    }
+    device->mmu.in_bios = false;
+    for (size_t i = 0; i < sizeof(serialTestProgram); i++) {
+        GB_deviceWriteByte(device, SERIAL_TEST_PROGRAM_START + i, serialTestProgram[i]);
+    }
+    device->cpu.registers.pc = SERIAL_TEST_PROGRAM_START;
+    memset(log, 0, sizeof(SerialTestLog));
+    GBSerialSetByteCallback(device, logSerialByte, log);
+    return device;
+}
+
+int test_serial() {
+    int fails = 0;
+    SerialTestLog log;
+    GB_device* device = newSerialTestDevice(&log);
+    if (device == NULL) {
+        printf("⛔️ serial test ROM could not be loaded\n");
+        return 1;
+    }
+
+    // run up to the first SC write
+    while (device->cpu.registers.pc != SERIAL_TEST_PROGRAM_START + 8) {
+        GB_emulationStep(device);
+    }
+    uint64_t started = device->mmu.cycleCount;
+    for (int i = 0; i < 20000 && log.count < 2; i++) {
+        GB_emulationStep(device);
+    }
+
+    if (log.count == 2 && log.bytes[0] == 'H' && log.bytes[1] == 'i') {
+        printf("✅ serial bytes reach the sink\n");
+    } else {
+        printf("⛔️ serial sink got %d bytes\n", log.count);
+        fails++;
+    }
+    // the write lands on the last cycle of LDH, the event on the instruction that reaches it
+    uint64_t elapsed = log.cycles[0] - started;
+    if (log.count > 0 && elapsed + 12 >= GB_SERIAL_TRANSFER_CYCLES && elapsed <= GB_SERIAL_TRANSFER_CYCLES + 24) {
+        printf("✅ serial byte completes after one transfer time\n");
+    } else {
+        printf("⛔️ serial byte completed after %llu cycles\n", (unsigned long long)elapsed);
+        fails++;
+    }
+    if (device->mmu.sb == 0xFF && (device->mmu.sc & 0x80) == 0 &&
+        (device->mmu.interruptRequest & GB_INTERRUPT_FLAG_SERIAL) != 0) {
+        printf("✅ serial registers and interrupt after transfer\n");
+    } else {
+        printf("⛔️ serial registers after transfer sb %02x sc %02x if %02x\n",
+               device->mmu.sb, device->mmu.sc, device->mmu.interruptRequest);
+        fails++;
+    }
+
+    // an external clock transfer never completes without a partner, and
+    // a device copied over keeps its own sink
+    SerialTestLog copyLog;
+    GB_device* copy = newSerialTestDevice(&copyLog);
+    GB_deviceWriteByte(device, 0xFF01, 'x');
+    GB_deviceWriteByte(device, 0xFF02, 0x80);
+    GB_copyDeviceState(copy, device);
+    for (int i = 0; i < 4 * GB_SERIAL_TRANSFER_CYCLES; i++) {
+        GB_emulationStep(device);
+    }
+    GB_deviceWriteByte(copy, 0xFF02, 0x81);
+    for (int i = 0; i < 4 * GB_SERIAL_TRANSFER_CYCLES; i++) {
+        GB_emulationStep(copy);
+    }
+    if (log.count == 2 && copyLog.count == 1 && copyLog.bytes[0] == 'x') {
+        printf("✅ serial external clock waits, copies keep their sink\n");
+    } else {
+        printf("⛔️ serial sink got %d bytes, the copy's %d\n", log.count, copyLog.count);
+        fails++;
+    }
+
+    GB_freeDevice(copy);
+    GB_freeDevice(device);
+    return fails;
+}
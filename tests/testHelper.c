@@ -2,11 +2,21 @@
 #include "core/Device.h"
 #include "core/PPU.h"
 #include "core/MMU.h"
+#include "core/APU.h"
+#include "core/FrameHash.h"
 
 #include <string.h>
 #include <stdlib.h>
 
 #define TEST_BLOCK_SIZE 50
+// completion is checked every this many instructions
+#define TEST_DONE_CHECK_INTERVAL 256
+// a stalled ROM gets at most this many instructions to finish its frame
+#define TEST_STALL_FRAME_STEPS 0x20000
+// consecutive checks that must find the CPU in the same dead loop
+#define TEST_STALL_CHECKS 4
+
+#define BLARGG_STATUS_RUNNING 0x80
 
 GBTestSuite* GBNewTestSuite(char* name, GBTestCase* test, int testsLen) {
     GBTestSuite * suite = malloc(sizeof(GBTestSuite));
@@ -52,27 +62,176 @@ uint8_t _crc8(uint8_t const *data, size_t nBytes, int start, int stride) {
     return remainder ^ 0xFF;
 }
 
-int testRomWithCRC(char* romPath, u_int64_t steps, u_int32_t crcCheck) {
+static uint32_t _screenCRC(GB_device* device);
 
+GB_device* testNewRomDevice(const char* romPath, GBApuAudioMode audioMode) {
     GB_device* device = GB_newDevice();
-    GB_deviceloadRom(device, romPath);
-    u_int64_t testlen = steps;
+    GBApuSetAudioMode(device, audioMode);
+    if (audioMode == GBApuAudioModeFull) {
+        // nobody reads the output, the ring just drops what does not fit
+        GBApuSetSampleRate(device, GB_TEST_SAMPLE_RATE);
+    }
+    if (GB_deviceloadRom(device, romPath) != GB_CARTRIDGE_SUCCESS) {
+        GB_freeDevice(device);
+        return NULL;
+    }
+    return device;
+}
+
+uint64_t testDeviceFingerprint(GB_device* device, int extraRegions) {
+    int regions = GBHashRegionFrame | GBHashRegionWRAM | GBHashRegionVRAM | extraRegions;
+    uint64_t hash = GB_device_hash(device, regions);
+    hash = GB_hash64(&device->cpu.registers, sizeof(device->cpu.registers), hash);
+    hash = GB_hash64(device->mmu.zRam, sizeof(device->mmu.zRam), hash);
+    return GB_hash64(device->apu.data, sizeof(device->apu.data), hash);
+}
+
+uint64_t testRunFrames(GB_device* device, int frames) {
+    for (int i = 0; i < frames; i++) {
+        GB_runFrame(device);
+    }
+    return testDeviceFingerprint(device, 0);
+}
+
+int testRomCRC(const char* romPath, GBApuAudioMode audioMode, uint64_t steps, uint32_t* crcOut) {
+
+    GB_device* device = testNewRomDevice(romPath, audioMode);
+    if (device == NULL) {
+        return GB_TEST_FAIL;
+    }
+    uint64_t testlen = steps;
     while (testlen != 0){
         testlen--;
         GB_emulationStep(device);
     }
 
-    uint8_t crc1 = _crc8((uint8_t *)device->ppu->frameBuffer[GBBackgroundFrameBuffer], sizeof(int32_t) * 160 * 144, 0, 1);
-    uint8_t crc2 = _crc8((uint8_t *)device->ppu->frameBuffer[GBBackgroundFrameBuffer], sizeof(int32_t) * 160 * 144, 0, 2);
-    uint8_t crc3 = _crc8((uint8_t *)device->ppu->frameBuffer[GBBackgroundFrameBuffer], sizeof(int32_t) * 160 * 144, 1, 2);
-    uint8_t crc4 = _crc8((uint8_t *)device->ppu->frameBuffer[GBObjectFrameBuffer], sizeof(int32_t) * 160 * 144, 0, 1);
-   
+    *crcOut = _screenCRC(device);
     GB_freeDevice(device);
-    if (crc1 == (crcCheck & 0xFF) &&
-        crc2 == ((crcCheck >> 8) & 0xFF) && 
-        crc3 == ((crcCheck >> 16) & 0xFF) &&
-        crc4 == ((crcCheck >> 24) & 0xFF)) {
+    return GB_TEST_OK;
+}
+
+static uint32_t _screenCRC(GB_device* device) {
+    uint8_t crc1 = _crc8((uint8_t *)device->ppu.frameBuffer[GBBackgroundFrameBuffer], sizeof(int32_t) * 160 * 144, 0, 1);
+    uint8_t crc2 = _crc8((uint8_t *)device->ppu.frameBuffer[GBBackgroundFrameBuffer], sizeof(int32_t) * 160 * 144, 0, 2);
+    uint8_t crc3 = _crc8((uint8_t *)device->ppu.frameBuffer[GBBackgroundFrameBuffer], sizeof(int32_t) * 160 * 144, 1, 2);
+    uint8_t crc4 = _crc8((uint8_t *)device->ppu.frameBuffer[GBObjectFrameBuffer], sizeof(int32_t) * 160 * 144, 0, 1);
+
+    return crc1 | (crc2 << 8) | (crc3 << 16) | ((uint32_t)crc4 << 24);
+}
+
+int testRomWithCRC(char* romPath, GBApuAudioMode audioMode, uint64_t steps, uint32_t crcCheck) {
+    uint32_t crc;
+    if (testRomCRC(romPath, audioMode, steps, &crc) == GB_TEST_OK && crc == crcCheck) {
         return GB_TEST_OK;
     }
     return GB_TEST_FAIL;
-}
\ No newline at end of file
+}
+
+static bool _hasBlarggSignature(GB_device* device) {
+    return device->mmu.eRam[1] == 0xDE && device->mmu.eRam[2] == 0xB0 && device->mmu.eRam[3] == 0x61;
+}
+
+// A JR -2 the CPU can never leave: no interrupt can be taken, with IME
+// off (and no EI pending) or none of them enabled. Passing through such a
+// loop once is not enough, the PC must be found on it `TEST_STALL_CHECKS`
+// checks in a row.
+static bool _isStalled(GB_device* device, Word* stallPC, int* stallChecks) {
+    Word pc = device->cpu.registers.pc;
+    bool jumpsToItself = GB_deviceReadByte(device, pc) == 0x18 && GB_deviceReadByte(device, pc + 1) == 0xFE;
+    bool interruptsOff = (device->cpu.IME == false && device->cpu.enableINT == 0) ||
+                         (device->mmu.interruptEnable & 0x1F) == 0;
+    if (jumpsToItself == false || interruptsOff == false) {
+        *stallChecks = 0;
+        return false;
+    }
+    if (*stallChecks == 0 || pc != *stallPC) {
+        *stallPC = pc;
+        *stallChecks = 0;
+    }
+    return ++*stallChecks >= TEST_STALL_CHECKS;
+}
+
+struct SerialCapture_s {
+    char* text;
+    size_t length;
+    bool updated;
+};
+
+typedef struct SerialCapture_s SerialCapture;
+
+static void _captureSerialByte(void* sender, GB_device* device, Byte value) {
+    SerialCapture* capture = sender;
+    if (capture->length + 1 < GB_TEST_TEXT_SIZE) {
+        capture->text[capture->length++] = value;
+        capture->text[capture->length] = '\0';
+        capture->updated = true;
+    }
+}
+
+void testRomUntilDone(const char* romPath, GBApuAudioMode audioMode, uint64_t maxSteps, GBTestRomResult* result) {
+    memset(result, 0, sizeof(GBTestRomResult));
+    // ROMs without cartridge RAM print their verdict over the serial port
+    SerialCapture serial = {result->text, 0, false};
+
+    GB_device* device = testNewRomDevice(romPath, audioMode);
+    if (device == NULL) {
+        result->outcome = GBTestRomLoadError;
+        return;
+    }
+    GBSerialSetByteCallback(device, _captureSerialByte, &serial);
+
+    // The signature is written before the running status, so a result
+    // only counts once the ROM has been seen running.
+    bool running = false;
+    Word stallPC = 0;
+    int stallChecks = 0;
+    result->outcome = GBTestRomTimedOut;
+    uint64_t steps = 0;
+    while (steps < maxSteps) {
+        GB_emulationStep(device);
+        steps++;
+        if (steps % TEST_DONE_CHECK_INTERVAL != 0) {
+            continue;
+        }
+        if (_hasBlarggSignature(device)) {
+            uint8_t status = device->mmu.eRam[0];
+            if (status == BLARGG_STATUS_RUNNING) {
+                running = true;
+            } else if (running) {
+                result->code = status;
+                result->outcome = status == 0 ? GBTestRomPassed : GBTestRomFailed;
+                break;
+            }
+        }
+        if (running == false && serial.updated) {
+            serial.updated = false;
+            if (strstr(serial.text, "Passed") != NULL) {
+                result->outcome = GBTestRomPassed;
+                break;
+            }
+            if (strstr(serial.text, "Failed") != NULL) {
+                result->outcome = GBTestRomFailed;
+                break;
+            }
+        }
+        if (_isStalled(device, &stallPC, &stallChecks)) {
+            result->outcome = GBTestRomStalled;
+            device->ppu.frameReady = false;
+            for (int i = 0; i < TEST_STALL_FRAME_STEPS && device->ppu.frameReady == false; i++) {
+                GB_emulationStep(device);
+            }
+            break;
+        }
+    }
+
+    if (running) {
+        const char* text = (const char*)&device->mmu.eRam[4];
+        const char* end = memchr(text, '\0', GB_TEST_TEXT_SIZE - 1);
+        size_t length = end != NULL ? (size_t)(end - text) : GB_TEST_TEXT_SIZE - 1;
+        memcpy(result->text, text, length);
+        result->text[length] = '\0';
+    }
+    result->steps = steps;
+    result->crc = _screenCRC(device);
+    GB_freeDevice(device);
+}
@@ -1,9 +1,16 @@
+#pragma once
+
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include "core/definitions.h"
+#include "core/APU.h"
 
 #define GB_TEST_OK 0
 #define GB_TEST_FAIL 1
 
+#define GB_TEST_TEXT_SIZE 256
+
 typedef int (*GBTestFunc)();
 
 struct GBTestCase_s {
@@ -24,5 +31,63 @@ typedef struct GBTestSuite_s GBTestSuite;
 GBTestSuite* GBNewTestSuite(char* name, GBTestCase* test, int testsLen);
 // void GBAddTestCase(GBTestSuite* suite, GBTestCase test);
 
-int testRomWithCRC(char* romPath, u_int64_t steps, u_int32_t crcCheck);
+// How a test ROM run ended, see testRomUntilDone.
+enum GBTestRomOutcome_e {
+    // the ROM reported its own result, through the Blargg signature at
+    // $A000 or as "Passed"/"Failed" on the serial port
+    GBTestRomPassed,
+    GBTestRomFailed,
+    // the ROM parked itself in a JR -2 loop without reporting a result
+    GBTestRomStalled,
+    // neither happened within the step budget
+    GBTestRomTimedOut,
+    GBTestRomLoadError,
+};
+
+typedef enum GBTestRomOutcome_e GBTestRomOutcome;
+
+struct GBTestRomResult_s {
+    GBTestRomOutcome outcome;
+    // Blargg result code, 0 is a pass (only set by the $A000 protocol)
+    uint8_t code;
+    uint64_t steps;
+    // screen checksums as packed by testRomCRC
+    uint32_t crc;
+    // text the ROM left at $A004, or its serial output
+    char text[GB_TEST_TEXT_SIZE];
+};
+
+typedef struct GBTestRomResult_s GBTestRomResult;
+
+int test_concurrent_devices();
+int test_serial();
+int test_run_ahead();
+int test_save_state();
+int test_rewind();
+int test_device_pool();
+int test_movie();
+int test_audio_capture();
+int test_gbs_player();
+// Checks a golden-frame suite (format in GoldenFrames.c), or records the
+// current hashes into it when `update` is set
+int testGoldenFrames(const char* suitePath, bool update);
+// The ROM runners take the APU mode to test: GBApuAudioModeFull synthesizes
+// at GB_TEST_SAMPLE_RATE (the samples are dropped), headless skips it.
+#define GB_TEST_SAMPLE_RATE 48000
+// Fresh device running `romPath`, NULL if the ROM could not be loaded
+GB_device* testNewRomDevice(const char* romPath, GBApuAudioMode audioMode);
+// Hash of the frame, WRAM, VRAM and `extraRegions` (a GBHashRegion mask),
+// chained with the CPU registers, high RAM and the APU registers: equal for
+// devices in the same state
+uint64_t testDeviceFingerprint(GB_device* device, int extraRegions);
+// Runs `frames` frames, returns the fingerprint of where they ended
+uint64_t testRunFrames(GB_device* device, int frames);
+// Runs a ROM and packs the four screen checksums into crcOut.
+// Fails only if the ROM could not be loaded.
+int testRomCRC(const char* romPath, GBApuAudioMode audioMode, uint64_t steps, uint32_t* crcOut);
+int testRomWithCRC(char* romPath, GBApuAudioMode audioMode, uint64_t steps, uint32_t crcCheck);
+// Runs a ROM until it reports a result, stalls, or maxSteps instructions
+// have run. A stalled ROM gets one more frame so the screen checksum covers
+// a complete picture.
+void testRomUntilDone(const char* romPath, GBApuAudioMode audioMode, uint64_t maxSteps, GBTestRomResult* result);
 uint8_t _crc8(uint8_t const *data, size_t nBytes, int start, int stride);
\ No newline at end of file